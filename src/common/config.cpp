@@ -53,6 +53,7 @@ static bool isNullGpu = false;
 static bool shouldCopyGPUBuffers = false;
 static bool shouldDumpShaders = false;
 static bool shouldPatchShaders = true;
+static bool shouldOptimizeShaders = false;
 static u32 vblankDivider = 1;
 static bool vkValidation = false;
 static bool vkValidationSync = false;
@@ -258,6 +259,10 @@ bool patchShaders() {
     return shouldPatchShaders;
 }
 
+bool optimizeShaders() {
+    return shouldOptimizeShaders;
+}
+
 bool isRdocEnabled() {
     return rdocEnable;
 }
@@ -602,6 +607,7 @@ void load(const std::filesystem::path& path) {
         shouldCopyGPUBuffers = toml::find_or<bool>(gpu, "copyGPUBuffers", false);
         shouldDumpShaders = toml::find_or<bool>(gpu, "dumpShaders", false);
         shouldPatchShaders = toml::find_or<bool>(gpu, "patchShaders", true);
+        shouldOptimizeShaders = toml::find_or<bool>(gpu, "optimizeShaders", false);
         vblankDivider = toml::find_or<int>(gpu, "vblankDivider", 1);
         isFullscreen = toml::find_or<bool>(gpu, "Fullscreen", false);
         fullscreenMode = toml::find_or<std::string>(gpu, "FullscreenMode", "Windowed");
@@ -754,6 +760,7 @@ void save(const std::filesystem::path& path) {
     data["GPU"]["copyGPUBuffers"] = shouldCopyGPUBuffers;
     data["GPU"]["dumpShaders"] = shouldDumpShaders;
     data["GPU"]["patchShaders"] = shouldPatchShaders;
+    data["GPU"]["optimizeShaders"] = shouldOptimizeShaders;
     data["GPU"]["vblankDivider"] = vblankDivider;
     data["GPU"]["Fullscreen"] = isFullscreen;
     data["GPU"]["FullscreenMode"] = fullscreenMode;
@@ -845,6 +852,7 @@ void setDefaultValues() {
     isSideTrophy = "right";
     isNullGpu = false;
     shouldDumpShaders = false;
+    shouldOptimizeShaders = false;
     vblankDivider = 1;
     vkValidation = false;
     vkValidationSync = false;
@@ -87,6 +87,7 @@ int getSpecialPadClass();
 bool getPSNSignedIn();
 void setPSNSignedIn(bool sign); // no ui setting
 bool patchShaders();            // no set
+bool optimizeShaders();         // no set
 bool fpsColor();                // no set
 bool isNeoModeConsole();
 void setNeoMode(bool enable);  // no ui setting
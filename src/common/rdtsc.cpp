@@ -30,31 +30,61 @@ static u64 GetTimeNs() {
     return Multiplier * ((static_cast<u64>(filetime.dwHighDateTime) << 32) +
                          static_cast<u64>(filetime.dwLowDateTime) - WindowsEpochToUnixEpoch);
 #elif defined(__APPLE__)
-    return clock_gettime_nsec_np(CLOCK_REALTIME);
+    return clock_gettime_nsec_np(CLOCK_MONOTONIC_RAW);
 #else
+    // The raw clock is not slewed by NTP, which would otherwise bias the estimate.
     timespec ts;
-    clock_gettime(CLOCK_REALTIME, &ts);
+    clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
     return ts.tv_sec * SecondToNanoseconds + ts.tv_nsec;
 #endif
 }
 
+struct ClockSample {
+    u64 tsc;
+    u64 ns;
+};
+
+/// Pairs a host time reading with the counter, keeping the tightest of a few brackets so that
+/// preemption between the two reads does not skew the estimate.
+static ClockSample TakeClockSample() {
+    ClockSample best{};
+    u64 best_window = ~0ULL;
+    for (int i = 0; i < 8; i++) {
+        const u64 tsc_before = FencedRDTSC();
+        const u64 ns = GetTimeNs();
+        const u64 tsc_after = FencedRDTSC();
+        if (tsc_after - tsc_before < best_window) {
+            best_window = tsc_after - tsc_before;
+            best = {tsc_before + best_window / 2, ns};
+        }
+    }
+    return best;
+}
+
 u64 EstimateRDTSCFrequency() {
     // Discard the first result measuring the rdtsc.
     FencedRDTSC();
     std::this_thread::sleep_for(std::chrono::milliseconds{1});
     FencedRDTSC();
 
-    // Get the current time.
-    const auto start_time = GetTimeNs();
-    const u64 tsc_start = FencedRDTSC();
-    // Wait for 100 milliseconds.
-    std::this_thread::sleep_for(std::chrono::milliseconds{100});
-    const auto end_time = GetTimeNs();
-    const u64 tsc_end = FencedRDTSC();
-    // Calculate differences.
-    const u64 tsc_diff = tsc_end - tsc_start;
-    const u64 tsc_freq = MultiplyAndDivide64(tsc_diff, 1000000000ULL, end_time - start_time);
-    return RoundToNearest<100'000>(tsc_freq);
+    // Extend the measured interval until consecutive estimates agree to within 1 ppm, or give
+    // up after a bounded amount of time and use the longest baseline.
+    static constexpr int MinSteps = 4;
+    static constexpr int MaxSteps = 20;
+    const auto start = TakeClockSample();
+    u64 tsc_freq = 0;
+    for (int step = 0; step < MaxSteps; step++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds{25});
+        const auto end = TakeClockSample();
+        const u64 estimate = MultiplyAndDivide64(end.tsc - start.tsc, SecondToNanoseconds,
+                                                 end.ns - start.ns);
+        const u64 delta = estimate > tsc_freq ? estimate - tsc_freq : tsc_freq - estimate;
+        tsc_freq = estimate;
+        if (step >= MinSteps && delta <= estimate / 1'000'000) {
+            break;
+        }
+    }
+    return RoundToNearest<10'000>(tsc_freq);
 }
 
 } // namespace Common
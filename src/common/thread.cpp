@@ -2,10 +2,13 @@
 // SPDX-FileCopyrightText: 2014 Citra Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
+#include <cstdlib>
 #include <ctime>
 #include <string>
 #include <thread>
 
+#include "common/debug.h"
 #include "common/error.h"
 #include "common/logging/log.h"
 #include "common/thread.h"
@@ -28,6 +31,11 @@
 #ifndef _WIN32
 #include <unistd.h>
 #endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__)
+#include <xmmintrin.h>
+#endif
 
 #ifdef __FreeBSD__
 #define cpu_set_t cpuset_t
@@ -105,10 +113,7 @@ void SetCurrentThreadPriority(ThreadPriority new_priority) {
     SetThreadPriority(handle, windows_priority);
 }
 
-bool AccurateSleep(const std::chrono::nanoseconds duration, std::chrono::nanoseconds* remaining,
-                   const bool interruptible) {
-    const auto begin_sleep = std::chrono::high_resolution_clock::now();
-
+static bool HostSleep(const std::chrono::nanoseconds duration, const bool interruptible) {
     LARGE_INTEGER interval{
         .QuadPart = -1 * (duration.count() / 100u),
     };
@@ -116,12 +121,6 @@ bool AccurateSleep(const std::chrono::nanoseconds duration, std::chrono::nanosec
     SetWaitableTimer(timer, &interval, 0, NULL, NULL, 0);
     const auto ret = WaitForSingleObjectEx(timer, INFINITE, interruptible);
     ::CloseHandle(timer);
-
-    if (remaining) {
-        const auto end_sleep = std::chrono::high_resolution_clock::now();
-        const auto sleep_time = end_sleep - begin_sleep;
-        *remaining = duration > sleep_time ? duration - sleep_time : std::chrono::nanoseconds(0);
-    }
     return ret == WAIT_OBJECT_0;
 }
 
@@ -145,8 +144,7 @@ void SetCurrentThreadPriority(ThreadPriority new_priority) {
     pthread_setschedparam(this_thread, scheduling_type, &params);
 }
 
-bool AccurateSleep(const std::chrono::nanoseconds duration, std::chrono::nanoseconds* remaining,
-                   const bool interruptible) {
+static bool HostSleep(const std::chrono::nanoseconds duration, const bool interruptible) {
     timespec request = {
         .tv_sec = duration.count() / 1'000'000'000,
         .tv_nsec = duration.count() % 1'000'000'000,
@@ -159,14 +157,111 @@ bool AccurateSleep(const std::chrono::nanoseconds duration, std::chrono::nanosec
         }
         request = remain;
     }
-    if (remaining) {
-        *remaining = std::chrono::nanoseconds(remain.tv_sec * 1'000'000'000 + remain.tv_nsec);
-    }
     return ret == 0 || errno != EINTR;
 }
 
 #endif
 
+namespace {
+
+/// Sleeps this short are only used as yield points, so they skip the timer entirely.
+constexpr std::chrono::nanoseconds YieldThreshold = std::chrono::microseconds{1};
+/// Wake-up latency assumed for a thread that has not slept on the host yet.
+constexpr s64 InitialWakeLatencyNs = 50'000;
+/// Upper bound on the busy-wait tail, keeps a badly calibrated thread from burning a core.
+constexpr s64 MaxSpinTailNs = 2'000'000;
+
+/// Running estimate of how late the host scheduler wakes the current thread after a sleep.
+struct WakeLatency {
+    s64 mean_ns = InitialWakeLatencyNs;
+    s64 deviation_ns = 0;
+
+    std::chrono::nanoseconds SpinTail() const {
+        return std::chrono::nanoseconds{std::clamp<s64>(mean_ns + 2 * deviation_ns, 0,
+                                                        MaxSpinTailNs)};
+    }
+
+    void Update(s64 overshoot_ns) {
+        const s64 error = overshoot_ns - mean_ns;
+        mean_ns += error / 8;
+        deviation_ns += (std::abs(error) - deviation_ns) / 4;
+    }
+};
+
+thread_local WakeLatency wake_latency;
+
+SleepStats sleep_stats;
+
+void ThreadPause() {
+#if defined(__x86_64__) || defined(_M_AMD64)
+    _mm_pause();
+#elif defined(_MSC_VER) && defined(_M_ARM64)
+    __yield();
+#elif defined(__aarch64__)
+    asm("yield");
+#endif
+}
+
+void RecordOvershoot(std::chrono::nanoseconds overshoot) {
+    const u64 overshoot_ns = std::max<s64>(overshoot.count(), 0);
+    sleep_stats.sleeps.fetch_add(1, std::memory_order_relaxed);
+    sleep_stats.total_overshoot_ns.fetch_add(overshoot_ns, std::memory_order_relaxed);
+    u64 max_ns = sleep_stats.max_overshoot_ns.load(std::memory_order_relaxed);
+    while (overshoot_ns > max_ns && !sleep_stats.max_overshoot_ns.compare_exchange_weak(
+                                        max_ns, overshoot_ns, std::memory_order_relaxed)) {
+    }
+    TracyPlot("Sleep overshoot (us)", static_cast<double>(overshoot_ns) / 1000.0);
+}
+
+} // Anonymous namespace
+
+bool AccurateSleep(const std::chrono::nanoseconds duration, std::chrono::nanoseconds* remaining,
+                   const bool interruptible) {
+    using Clock = std::chrono::steady_clock;
+    if (duration <= YieldThreshold) {
+        std::this_thread::yield();
+        sleep_stats.yields.fetch_add(1, std::memory_order_relaxed);
+        if (remaining) {
+            *remaining = std::chrono::nanoseconds{0};
+        }
+        return true;
+    }
+
+    // Hand most of the wait to the host and busy-wait only for the part it would likely
+    // oversleep, as learned from previous sleeps on this thread.
+    const auto begin = Clock::now();
+    const auto deadline = begin + duration;
+    const auto spin_tail = wake_latency.SpinTail();
+    if (duration > spin_tail) {
+        const auto host_duration = duration - spin_tail;
+        const bool uninterrupted = HostSleep(host_duration, interruptible);
+        const auto woken = Clock::now();
+        if (!uninterrupted) {
+            if (remaining) {
+                *remaining = std::max<std::chrono::nanoseconds>(deadline - woken,
+                                                                std::chrono::nanoseconds{0});
+            }
+            return false;
+        }
+        wake_latency.Update((woken - begin - host_duration).count());
+    }
+
+    auto now = Clock::now();
+    while (now < deadline) {
+        ThreadPause();
+        now = Clock::now();
+    }
+    RecordOvershoot(now - deadline);
+    if (remaining) {
+        *remaining = std::chrono::nanoseconds{0};
+    }
+    return true;
+}
+
+const SleepStats& GetSleepStats() {
+    return sleep_stats;
+}
+
 #ifdef _MSC_VER
 
 // Sets the debugger-visible name of the current thread.
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <chrono>
 #include "common/types.h"
 
@@ -25,9 +26,21 @@ void SetCurrentThreadName(const char* name);
 
 void SetThreadName(void* thread, const char* name);
 
+/// Sleeps for the given duration, spinning for the tail that the host scheduler would otherwise
+/// oversleep. Sleeps of a microsecond or less only yield the CPU.
 bool AccurateSleep(std::chrono::nanoseconds duration, std::chrono::nanoseconds* remaining,
                    bool interruptible);
 
+/// Process-wide AccurateSleep counters, shown by the performance overlay.
+struct SleepStats {
+    std::atomic<u64> sleeps{0};
+    std::atomic<u64> yields{0};
+    std::atomic<u64> total_overshoot_ns{0};
+    std::atomic<u64> max_overshoot_ns{0};
+};
+
+const SleepStats& GetSleepStats();
+
 class AccurateTimer {
     std::chrono::nanoseconds target_interval{};
     std::chrono::nanoseconds total_wait{};
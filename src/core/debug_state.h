@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <atomic>
 #include <mutex>
 #include <shared_mutex>
@@ -143,6 +144,14 @@ class DebugStateImpl {
     std::atomic_int32_t flip_frame_count = 0;
     std::atomic_int32_t gnm_frame_count = 0;
 
+    std::atomic_uint32_t num_draws = 0;
+    std::atomic_uint32_t num_state_reused_draws = 0;
+    std::atomic_uint32_t last_frame_draws = 0;
+    std::atomic_uint32_t last_frame_state_reused_draws = 0;
+    std::atomic_uint32_t num_render_passes = 0;
+    std::atomic_uint32_t last_frame_render_passes = 0;
+    std::atomic_uint32_t input_latency_us = 0;
+
     s32 gnm_frame_dump_request_count = -1;
     std::unordered_map<size_t, FrameDump*> waiting_reg_dumps;
     std::unordered_map<size_t, std::string> waiting_reg_dumps_dbg;
@@ -192,6 +201,31 @@ public:
     void IncGnmFrameNum() {
         ++gnm_frame_count;
         --gnm_frame_dump_request_count;
+
+        last_frame_draws = num_draws.exchange(0);
+        last_frame_state_reused_draws = num_state_reused_draws.exchange(0);
+        last_frame_render_passes = num_render_passes.exchange(0);
+    }
+
+    /// Counts a draw issued by the renderer, state reused draws found their pipeline already bound.
+    void CountDraw(bool is_state_reused) {
+        ++num_draws;
+        if (is_state_reused) {
+            ++num_state_reused_draws;
+        }
+    }
+
+    void CountRenderPass() {
+        ++num_render_passes;
+    }
+
+    /// Folds the delay between an input sample and its first guest read into a running average.
+    void RecordInputLatency(u64 latency_us) {
+        const s64 sample = static_cast<s64>(std::min<u64>(latency_us, UINT32_MAX));
+        const s64 average = input_latency_us.load(std::memory_order_relaxed);
+        input_latency_us.store(static_cast<u32>(average == 0 ? sample
+                                                             : average + (sample - average) / 8),
+                               std::memory_order_relaxed);
     }
 
     u32 GetFrameNum() const {
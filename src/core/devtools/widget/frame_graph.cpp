@@ -5,6 +5,7 @@
 
 #include "common/config.h"
 #include "common/singleton.h"
+#include "common/thread.h"
 #include "core/debug_state.h"
 #include "imgui.h"
 #include "imgui_internal.h"
@@ -97,6 +98,16 @@ void FrameGraph::Draw() {
         Text("Presenter time: %.3f ms (%.1f FPS)", io.DeltaTime * 1000.0f, 1.0f / io.DeltaTime);
         Text("Flip frame: %d Gnm submit frame: %d", DebugState.flip_frame_count.load(),
              DebugState.gnm_frame_count.load());
+        Text("Draws: %u (state reused: %u)", DebugState.last_frame_draws.load(),
+             DebugState.last_frame_state_reused_draws.load());
+        Text("Render passes: %u", DebugState.last_frame_render_passes.load());
+        Text("Input latency: %.2f ms", DebugState.input_latency_us.load() / 1000.0f);
+        const auto& sleep_stats = Common::GetSleepStats();
+        const u64 sleeps = sleep_stats.sleeps.load();
+        Text("Sleep overshoot: %.1f us avg, %.1f us max (%llu sleeps, %llu yields)",
+             sleeps ? sleep_stats.total_overshoot_ns.load() / 1000.0 / sleeps : 0.0,
+             sleep_stats.max_overshoot_ns.load() / 1000.0, static_cast<unsigned long long>(sleeps),
+             static_cast<unsigned long long>(sleep_stats.yields.load()));
         Text("Game Res: %dx%d", DebugState.game_resolution.first,
              DebugState.game_resolution.second);
         Text("Output Res: %dx%d", DebugState.output_resolution.first,
@@ -43,6 +43,24 @@ void PS4_SYSV_ABI _sceFiberCheckStackOverflow(OrbisFiberContext* ctx) {
     }
 }
 
+static void SetupContext(OrbisFiber* fiber) {
+    fiber->context_start = fiber->addr_context;
+    fiber->context_end = reinterpret_cast<u8*>(fiber->addr_context) + fiber->size_context;
+
+    /* Apply signature to start of stack */
+    *(u64*)fiber->addr_context = kFiberStackSignature;
+
+    if (fiber->flags & FiberFlags::ContextSizeCheck) {
+        u64* stack_start = reinterpret_cast<u64*>(fiber->context_start);
+        u64* stack_end = reinterpret_cast<u64*>(fiber->context_end);
+
+        u64* stack_ptr = stack_start + 1;
+        while (stack_ptr < stack_end) {
+            *stack_ptr++ = kFiberStackSizeCheck;
+        }
+    }
+}
+
 s32 PS4_SYSV_ABI _sceFiberAttachContext(OrbisFiber* fiber, void* addr_context, u64 size_context) {
     if (size_context && size_context < ORBIS_FIBER_CONTEXT_MINIMUM_SIZE) {
         return ORBIS_FIBER_ERROR_RANGE;
@@ -59,22 +77,7 @@ s32 PS4_SYSV_ABI _sceFiberAttachContext(OrbisFiber* fiber, void* addr_context, u
 
     fiber->addr_context = addr_context;
     fiber->size_context = size_context;
-    fiber->context_start = addr_context;
-    fiber->context_end = reinterpret_cast<u8*>(addr_context) + size_context;
-
-    /* Apply signature to start of stack */
-    *(u64*)addr_context = kFiberStackSignature;
-
-    if (fiber->flags & FiberFlags::ContextSizeCheck) {
-        u64* stack_start = reinterpret_cast<u64*>(fiber->context_start);
-        u64* stack_end = reinterpret_cast<u64*>(fiber->context_end);
-
-        u64* stack_ptr = stack_start + 1;
-        while (stack_ptr < stack_end) {
-            *stack_ptr++ = kFiberStackSizeCheck;
-        }
-    }
-
+    SetupContext(fiber);
     return ORBIS_OK;
 }
 
@@ -205,21 +208,7 @@ s32 PS4_SYSV_ABI sceFiberInitializeImpl(OrbisFiber* fiber, const char* name, Orb
     fiber->magic_end = kFiberSignature1;
 
     if (addr_context != nullptr) {
-        fiber->context_start = addr_context;
-        fiber->context_end = reinterpret_cast<u8*>(addr_context) + size_context;
-
-        /* Apply signature to start of stack */
-        *(u64*)addr_context = kFiberStackSignature;
-
-        if (flags & FiberFlags::ContextSizeCheck) {
-            u64* stack_start = reinterpret_cast<u64*>(fiber->context_start);
-            u64* stack_end = reinterpret_cast<u64*>(fiber->context_end);
-
-            u64* stack_ptr = stack_start + 1;
-            while (stack_ptr < stack_end) {
-                *stack_ptr++ = kFiberStackSizeCheck;
-            }
-        }
+        SetupContext(fiber);
     }
 
     fiber->state = FiberState::Idle;
@@ -463,10 +452,8 @@ s32 PS4_SYSV_ABI sceFiberGetInfo(OrbisFiber* fiber, OrbisFiberInfo* fiber_info)
 
         if (*stack_start == kFiberStackSignature) {
             u64* stack_ptr = stack_start + 1;
-            while (stack_ptr < stack_end) {
-                if (*stack_ptr == kFiberStackSizeCheck) {
-                    stack_ptr++;
-                }
+            while (stack_ptr < stack_end && *stack_ptr == kFiberStackSizeCheck) {
+                stack_ptr++;
             }
 
             stack_margin =
@@ -3,20 +3,15 @@
 
 .global _sceFiberSetJmp
 _sceFiberSetJmp:
-    movq %rax, 0x0(%rdi)
-
+    # Only the return address and the callee-saved state survive a call, nothing else needs
+    # to be kept across a switch.
     movq (%rsp), %rdx
     movq %rdx, 0x10(%rdi)
 
-    movq %rcx, 0x08(%rdi)
     movq %rbx, 0x18(%rdi)
     movq %rsp, 0x20(%rdi)
     movq %rbp, 0x28(%rdi)
 
-    movq %r8,  0x30(%rdi)
-    movq %r9,  0x38(%rdi)
-    movq %r10, 0x40(%rdi)
-    movq %r11, 0x48(%rdi)
     movq %r12, 0x50(%rdi)
     movq %r13, 0x58(%rdi)
     movq %r14, 0x60(%rdi)
@@ -30,34 +25,36 @@ _sceFiberSetJmp:
 
 .global _sceFiberLongJmp
 _sceFiberLongJmp:
-    # MXCSR = (MXCSR & 0x3f) ^ (ctx->mxcsr & ~0x3f)
+    # MXCSR = (MXCSR & 0x3f) ^ (ctx->mxcsr & ~0x3f), skipped when the control bits already match
     stmxcsr -0x4(%rsp)
+    movl -0x4(%rsp), %ecx
     movl 0x72(%rdi), %eax
+    xorl %ecx, %eax
     andl $0xffffffc0, %eax
-    movl -0x4(%rsp), %ecx
-    andl $0x3f, %ecx
+    jz .skip_mxcsr
     xorl %eax, %ecx
     movl %ecx, -0x4(%rsp)
     ldmxcsr -0x4(%rsp)
 
-    movq 0x00(%rdi), %rax
-    movq 0x08(%rdi), %rcx
+.skip_mxcsr:
+    # Same for the x87 control word
+    fnstcw -0x6(%rsp)
+    movw -0x6(%rsp), %ax
+    cmpw 0x70(%rdi), %ax
+    je .skip_fpucw
+    fldcw 0x70(%rdi)
+
+.skip_fpucw:
     movq 0x10(%rdi), %rdx
     movq 0x18(%rdi), %rbx
     movq 0x20(%rdi), %rsp
     movq 0x28(%rdi), %rbp
 
-    movq 0x30(%rdi), %r8
-    movq 0x38(%rdi), %r9
-    movq 0x40(%rdi), %r10
-    movq 0x48(%rdi), %r11
     movq 0x50(%rdi), %r12
     movq 0x58(%rdi), %r13
     movq 0x60(%rdi), %r14
     movq 0x68(%rdi), %r15
 
-    fldcw 0x70(%rdi)
-
     # Make the jump and return 1
     movq %rdx, 0x00(%rsp)
     movl $0x1, %eax
@@ -1,11 +1,15 @@
 // SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <atomic>
 #include <thread>
 
 #include "common/assert.h"
 #include "common/native_clock.h"
+#include "common/polyfill_thread.h"
+#include "common/rdtsc.h"
 #include "common/thread.h"
+#include "common/uint128.h"
 #include "core/libraries/kernel/kernel.h"
 #include "core/libraries/kernel/orbis_error.h"
 #include "core/libraries/kernel/posix_error.h"
@@ -30,6 +34,85 @@ namespace Libraries::Kernel {
 static u64 initial_ptc;
 static std::unique_ptr<Common::NativeClock> clock;
 
+/// Mirrors the time page the PS4 kernel maps into every process. Monotonic time is derived from
+/// unfenced TSC deltas alone, realtime adds an offset that a background thread keeps in sync with
+/// the host wall clock.
+struct TimePage {
+    u64 tsc_base;
+    u64 monotonic_base_ns;
+    u64 ns_factor;
+    std::atomic<s64> realtime_offset_ns;
+};
+
+static constexpr auto TimePageUpdateInterval = std::chrono::milliseconds{10};
+
+static TimePage time_page;
+static std::jthread time_page_thread;
+
+static u64 HostRealtimeNs() {
+#ifdef _WIN64
+    FILETIME ft;
+    GetSystemTimePreciseAsFileTime(&ft);
+    static constexpr u64 DeltaEpochIn100ns = 116444736000000000ULL;
+    const u64 time_100ns = (static_cast<u64>(ft.dwHighDateTime) << 32) | ft.dwLowDateTime;
+    return (time_100ns - DeltaEpochIn100ns) * 100;
+#else
+    timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return ts.tv_sec * 1'000'000'000ULL + ts.tv_nsec;
+#endif
+}
+
+static u64 HostMonotonicNs() {
+#ifdef _WIN64
+    LARGE_INTEGER pf;
+    LARGE_INTEGER pc;
+    QueryPerformanceFrequency(&pf);
+    QueryPerformanceCounter(&pc);
+    return Common::MultiplyAndDivide64(pc.QuadPart, 1'000'000'000ULL, pf.QuadPart);
+#else
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1'000'000'000ULL + ts.tv_nsec;
+#endif
+}
+
+static u64 TimePageMonotonicNs() {
+    const u64 delta = Common::UnfencedRDTSC() - time_page.tsc_base;
+    return time_page.monotonic_base_ns + Common::MultiplyHigh(delta, time_page.ns_factor);
+}
+
+static u64 TimePageRealtimeNs() {
+    return TimePageMonotonicNs() +
+           time_page.realtime_offset_ns.load(std::memory_order_relaxed);
+}
+
+static void UpdateTimePage() {
+    const s64 offset = static_cast<s64>(HostRealtimeNs() - TimePageMonotonicNs());
+    time_page.realtime_offset_ns.store(offset, std::memory_order_relaxed);
+}
+
+static void TimePageThread(std::stop_token stoken) {
+    Common::SetCurrentThreadName("shadPS4:TimePage");
+    while (Common::StoppableTimedWait(stoken, TimePageUpdateInterval)) {
+        UpdateTimePage();
+    }
+}
+
+static void InitTimePage() {
+    time_page.tsc_base = Common::FencedRDTSC();
+    time_page.monotonic_base_ns = HostMonotonicNs();
+    time_page.ns_factor =
+        Common::GetFixedPoint64Factor(std::nano::den, clock->GetTscFrequency());
+    UpdateTimePage();
+    time_page_thread = std::jthread{TimePageThread};
+}
+
+static void NsToTimespec(u64 ns, OrbisKernelTimespec* ts) {
+    ts->tv_sec = static_cast<s64>(ns / 1'000'000'000);
+    ts->tv_nsec = static_cast<s64>(ns % 1'000'000'000);
+}
+
 u64 PS4_SYSV_ABI sceKernelGetTscFrequency() {
     return clock->GetTscFrequency();
 }
@@ -48,7 +131,7 @@ u64 PS4_SYSV_ABI sceKernelGetProcessTimeCounterFrequency() {
 }
 
 u64 PS4_SYSV_ABI sceKernelReadTsc() {
-    return clock->GetUptime();
+    return Common::UnfencedRDTSC();
 }
 
 static s32 posix_nanosleep_impl(const OrbisKernelTimespec* rqtp, OrbisKernelTimespec* rmtp,
@@ -132,50 +215,29 @@ s32 PS4_SYSV_ABI posix_clock_gettime(u32 clock_id, OrbisKernelTimespec* ts) {
         clock_id = ORBIS_CLOCK_MONOTONIC;
     }
 
-#ifdef _WIN32
-    static const auto FileTimeTo100Ns = [](FILETIME& ft) { return *reinterpret_cast<u64*>(&ft); };
+    // Wall and monotonic clocks are served from the time page without entering the host kernel.
     switch (clock_id) {
     case ORBIS_CLOCK_REALTIME:
-    case ORBIS_CLOCK_REALTIME_PRECISE: {
-        FILETIME ft;
-        GetSystemTimePreciseAsFileTime(&ft);
-        static constexpr u64 DeltaEpochIn100ns = 116444736000000000ULL;
-        const u64 ns = FileTimeTo100Ns(ft) - DeltaEpochIn100ns;
-        ts->tv_sec = ns / 10'000'000;
-        ts->tv_nsec = (ns % 10'000'000) * 100;
-        return 0;
-    }
+    case ORBIS_CLOCK_REALTIME_PRECISE:
     case ORBIS_CLOCK_SECOND:
-    case ORBIS_CLOCK_REALTIME_FAST: {
-        FILETIME ft;
-        GetSystemTimeAsFileTime(&ft);
-        static constexpr u64 DeltaEpochIn100ns = 116444736000000000ULL;
-        const u64 ns = FileTimeTo100Ns(ft) - DeltaEpochIn100ns;
-        ts->tv_sec = ns / 10'000'000;
-        ts->tv_nsec = (ns % 10'000'000) * 100;
+    case ORBIS_CLOCK_REALTIME_FAST:
+        NsToTimespec(TimePageRealtimeNs(), ts);
         return 0;
-    }
     case ORBIS_CLOCK_UPTIME:
     case ORBIS_CLOCK_UPTIME_PRECISE:
     case ORBIS_CLOCK_MONOTONIC:
     case ORBIS_CLOCK_MONOTONIC_PRECISE:
     case ORBIS_CLOCK_UPTIME_FAST:
-    case ORBIS_CLOCK_MONOTONIC_FAST: {
-        static LARGE_INTEGER pf = [] {
-            LARGE_INTEGER res{};
-            QueryPerformanceFrequency(&pf);
-            return res;
-        }();
-
-        LARGE_INTEGER pc{};
-        if (!QueryPerformanceCounter(&pc)) {
-            SetPosixErrno(EFAULT);
-            return -1;
-        }
-        ts->tv_sec = pc.QuadPart / pf.QuadPart;
-        ts->tv_nsec = ((pc.QuadPart % pf.QuadPart) * 1000'000'000) / pf.QuadPart;
+    case ORBIS_CLOCK_MONOTONIC_FAST:
+        NsToTimespec(TimePageMonotonicNs(), ts);
         return 0;
+    default:
+        break;
     }
+
+#ifdef _WIN32
+    static const auto FileTimeTo100Ns = [](FILETIME& ft) { return *reinterpret_cast<u64*>(&ft); };
+    switch (clock_id) {
     case ORBIS_CLOCK_THREAD_CPUTIME_ID: {
         FILETIME ct, et, kt, ut;
         if (!GetThreadTimes(GetCurrentThread(), &ct, &et, &kt, &ut)) {
@@ -216,32 +278,6 @@ s32 PS4_SYSV_ABI posix_clock_gettime(u32 clock_id, OrbisKernelTimespec* ts) {
 #else
     clockid_t pclock_id;
     switch (clock_id) {
-    case ORBIS_CLOCK_REALTIME:
-    case ORBIS_CLOCK_REALTIME_PRECISE:
-        pclock_id = CLOCK_REALTIME;
-        break;
-    case ORBIS_CLOCK_SECOND:
-    case ORBIS_CLOCK_REALTIME_FAST:
-#ifdef CLOCK_REALTIME_COARSE
-        pclock_id = CLOCK_REALTIME_COARSE;
-#else
-        pclock_id = CLOCK_REALTIME;
-#endif
-        break;
-    case ORBIS_CLOCK_UPTIME:
-    case ORBIS_CLOCK_UPTIME_PRECISE:
-    case ORBIS_CLOCK_MONOTONIC:
-    case ORBIS_CLOCK_MONOTONIC_PRECISE:
-        pclock_id = CLOCK_MONOTONIC;
-        break;
-    case ORBIS_CLOCK_UPTIME_FAST:
-    case ORBIS_CLOCK_MONOTONIC_FAST:
-#ifdef CLOCK_MONOTONIC_COARSE
-        pclock_id = CLOCK_MONOTONIC_COARSE;
-#else
-        pclock_id = CLOCK_MONOTONIC;
-#endif
-        break;
     case ORBIS_CLOCK_THREAD_CPUTIME_ID:
         pclock_id = CLOCK_THREAD_CPUTIME_ID;
         break;
@@ -392,23 +428,12 @@ s32 PS4_SYSV_ABI sceKernelClockGetres(const u32 clock_id, OrbisKernelTimespec* r
 }
 
 s32 PS4_SYSV_ABI posix_gettimeofday(OrbisKernelTimeval* tp, OrbisKernelTimezone* tz) {
-#ifdef _WIN64
     if (tp) {
-        FILETIME filetime;
-        GetSystemTimePreciseAsFileTime(&filetime);
-
-        constexpr u64 UNIX_TIME_START = 0x295E9648864000;
-        constexpr u64 TICKS_PER_SECOND = 1000000;
-
-        u64 ticks = filetime.dwHighDateTime;
-        ticks <<= 32;
-        ticks |= filetime.dwLowDateTime;
-        ticks /= 10;
-        ticks -= UNIX_TIME_START;
-
-        tp->tv_sec = ticks / TICKS_PER_SECOND;
-        tp->tv_usec = ticks % TICKS_PER_SECOND;
+        const u64 us = TimePageRealtimeNs() / 1000;
+        tp->tv_sec = us / 1'000'000;
+        tp->tv_usec = us % 1'000'000;
     }
+#ifdef _WIN64
     if (tz) {
         static int tzflag = 0;
         if (!tzflag) {
@@ -420,21 +445,17 @@ s32 PS4_SYSV_ABI posix_gettimeofday(OrbisKernelTimeval* tp, OrbisKernelTimezone*
     }
     return 0;
 #else
+    if (!tz) {
+        return 0;
+    }
     struct timezone tzz;
     timeval tv;
-    const auto ret = gettimeofday(&tv, &tzz);
-    if (tp) {
-        tp->tv_sec = tv.tv_sec;
-        tp->tv_usec = tv.tv_usec;
-    }
-    if (tz) {
-        tz->tz_dsttime = tzz.tz_dsttime;
-        tz->tz_minuteswest = tzz.tz_minuteswest;
-    }
-    if (ret < 0) {
+    if (gettimeofday(&tv, &tzz) < 0) {
         SetPosixErrno(errno);
         return -1;
     }
+    tz->tz_dsttime = tzz.tz_dsttime;
+    tz->tz_minuteswest = tzz.tz_minuteswest;
     return 0;
 #endif
 }
@@ -511,6 +532,7 @@ s32 PS4_SYSV_ABI sceKernelConvertUtcToLocaltime(time_t time, time_t* local_time,
 void RegisterTime(Core::Loader::SymbolsResolver* sym) {
     clock = std::make_unique<Common::NativeClock>();
     initial_ptc = clock->GetUptime();
+    InitTimePage();
 
     // POSIX
     LIB_FUNCTION("yS8U2TGCe1A", "libkernel", 1, "libkernel", 1, 1, posix_nanosleep);
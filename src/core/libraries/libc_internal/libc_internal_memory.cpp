@@ -1,29 +1,86 @@
 // SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <cstring>
+
 #include "common/assert.h"
 #include "common/logging/log.h"
 #include "core/libraries/error_codes.h"
+#include "core/libraries/kernel/posix_error.h"
 #include "core/libraries/libs.h"
 #include "libc_internal_memory.h"
 
 namespace Libraries::LibcInternal {
 
+/// Annex K limit on object sizes, anything larger is treated as a negative size passed by mistake.
+static constexpr size_t RsizeMax = SIZE_MAX >> 1;
+
+// Bulk copies and fills are left to the host CRT, which already picks the widest vector or
+// rep movsb/stosb implementation for the running CPU.
+
 void* PS4_SYSV_ABI internal_memset(void* s, int c, size_t n) {
     return std::memset(s, c, n);
 }
 
+s32 PS4_SYSV_ABI internal_memset_s(void* s, size_t smax, int c, size_t n) {
+    if (!s || smax > RsizeMax) {
+        return POSIX_EINVAL;
+    }
+    // Once the destination is known to be valid, violations still fill it up to smax.
+    if (n > RsizeMax || n > smax) {
+        std::memset(s, c, smax);
+        return POSIX_EINVAL;
+    }
+    std::memset(s, c, n);
+    return 0;
+}
+
 void* PS4_SYSV_ABI internal_memcpy(void* dest, const void* src, size_t n) {
     return std::memcpy(dest, src, n);
 }
 
 s32 PS4_SYSV_ABI internal_memcpy_s(void* dest, size_t destsz, const void* src, size_t count) {
-#ifdef _WIN64
-    return memcpy_s(dest, destsz, src, count);
-#else
+    // Annex K checks the destination first, an invalid one is never written to.
+    if (!dest || destsz > RsizeMax) {
+        return POSIX_EINVAL;
+    }
+    if (!src || count > RsizeMax) {
+        std::memset(dest, 0, destsz);
+        return POSIX_EINVAL;
+    }
+    if (count > destsz) {
+        std::memset(dest, 0, destsz);
+        return POSIX_ERANGE;
+    }
+    const auto* dest_bytes = static_cast<const u8*>(dest);
+    const auto* src_bytes = static_cast<const u8*>(src);
+    if (dest_bytes < src_bytes + count && src_bytes < dest_bytes + count) {
+        std::memset(dest, 0, destsz);
+        return POSIX_EINVAL;
+    }
     std::memcpy(dest, src, count);
-    return 0; // ALL OK
-#endif
+    return 0;
+}
+
+void* PS4_SYSV_ABI internal_memmove(void* dest, const void* src, size_t n) {
+    return std::memmove(dest, src, n);
+}
+
+s32 PS4_SYSV_ABI internal_memmove_s(void* dest, size_t destsz, const void* src, size_t count) {
+    // Annex K checks the destination first, an invalid one is never written to.
+    if (!dest || destsz > RsizeMax) {
+        return POSIX_EINVAL;
+    }
+    if (!src || count > RsizeMax) {
+        std::memset(dest, 0, destsz);
+        return POSIX_EINVAL;
+    }
+    if (count > destsz) {
+        std::memset(dest, 0, destsz);
+        return POSIX_ERANGE;
+    }
+    std::memmove(dest, src, count);
+    return 0;
 }
 
 s32 PS4_SYSV_ABI internal_memcmp(const void* s1, const void* s2, size_t n) {
@@ -36,8 +93,14 @@ void RegisterlibSceLibcInternalMemory(Core::Loader::SymbolsResolver* sym) {
                  internal_memcpy_s);
     LIB_FUNCTION("Q3VBxCXhUHs", "libSceLibcInternal", 1, "libSceLibcInternal", 1, 1,
                  internal_memcpy);
+    LIB_FUNCTION("+P6FRGH4LfA", "libSceLibcInternal", 1, "libSceLibcInternal", 1, 1,
+                 internal_memmove);
+    LIB_FUNCTION("B59+zQQCcbU", "libSceLibcInternal", 1, "libSceLibcInternal", 1, 1,
+                 internal_memmove_s);
     LIB_FUNCTION("8zTFvBIAIN8", "libSceLibcInternal", 1, "libSceLibcInternal", 1, 1,
                  internal_memset);
+    LIB_FUNCTION("h8GwqPFbu6I", "libSceLibcInternal", 1, "libSceLibcInternal", 1, 1,
+                 internal_memset_s);
     LIB_FUNCTION("DfivPArhucg", "libSceLibcInternal", 1, "libSceLibcInternal", 1, 1,
                  internal_memcmp);
 }
@@ -1,59 +1,196 @@
 // SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <bit>
+#include <cstring>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
 #include "common/assert.h"
 #include "common/logging/log.h"
 #include "core/libraries/error_codes.h"
+#include "core/libraries/kernel/posix_error.h"
 #include "core/libraries/libs.h"
 #include "libc_internal_str.h"
 
 namespace Libraries::LibcInternal {
 
-s32 PS4_SYSV_ABI internal_strcpy_s(char* dest, size_t dest_size, const char* src) {
-#ifdef _WIN64
-    return strcpy_s(dest, dest_size, src);
+namespace {
+
+/// Annex K limit on object sizes, anything larger is treated as a negative size passed by mistake.
+constexpr size_t RsizeMax = SIZE_MAX >> 1;
+
+#ifdef __AVX2__
+constexpr uintptr_t VectorSize = 32;
+constexpr uintptr_t PageSize = 4_KB;
+
+/// Returns a bit per byte of the aligned 32-byte block at ptr that is zero.
+u32 ZeroMask(const char* ptr) {
+    const __m256i block = _mm256_load_si256(reinterpret_cast<const __m256i*>(ptr));
+    const __m256i zero = _mm256_cmpeq_epi8(block, _mm256_setzero_si256());
+    return static_cast<u32>(_mm256_movemask_epi8(zero));
+}
+
+/// Returns true when an unaligned 32-byte load at ptr stays within its page.
+bool CanLoadVector(const void* ptr) {
+    return (reinterpret_cast<uintptr_t>(ptr) & (PageSize - 1)) <= PageSize - VectorSize;
+}
+#endif
+
+/// Length of str, scanning at most max_len bytes. Aligned loads never cross into a page the
+/// guest string does not touch, so reading past the terminator is safe.
+size_t StrNLen(const char* str, size_t max_len) {
+#ifdef __AVX2__
+    const char* block = reinterpret_cast<const char*>(reinterpret_cast<uintptr_t>(str) &
+                                                      ~(VectorSize - 1));
+    // Bytes of the first block that precede str are shifted out of its mask.
+    u32 mask = ZeroMask(block) >> (str - block);
+    size_t length = 0;
+    if (mask == 0) {
+        length = VectorSize - (str - block);
+        while (length < max_len) {
+            block += VectorSize;
+            if (mask = ZeroMask(block); mask != 0) {
+                break;
+            }
+            length += VectorSize;
+        }
+    }
+    length += mask ? std::countr_zero(mask) : 0;
+    return length < max_len ? length : max_len;
 #else
-    std::strcpy(dest, src);
-    return 0; // ALL OK
+    const void* end = std::memchr(str, 0, max_len);
+    return end ? static_cast<const char*>(end) - str : max_len;
 #endif
 }
 
-s32 PS4_SYSV_ABI internal_strcat_s(char* dest, size_t dest_size, const char* src) {
-#ifdef _WIN64
-    return strcat_s(dest, dest_size, src);
-#else
-    std::strcat(dest, src);
-    return 0; // ALL OK
+/// Compares at most count bytes of two strings as unsigned chars, returning their difference.
+s32 StrNCmp(const char* str1, const char* str2, size_t count) {
+    const auto* s1 = reinterpret_cast<const u8*>(str1);
+    const auto* s2 = reinterpret_cast<const u8*>(str2);
+    while (count != 0) {
+#ifdef __AVX2__
+        if (CanLoadVector(s1) && CanLoadVector(s2)) {
+            const __m256i v1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s1));
+            const __m256i v2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s2));
+            const u32 equal = _mm256_movemask_epi8(_mm256_cmpeq_epi8(v1, v2));
+            const u32 zero = _mm256_movemask_epi8(_mm256_cmpeq_epi8(v1, _mm256_setzero_si256()));
+            u32 stop = ~equal | zero;
+            if (count < VectorSize) {
+                stop &= (1U << count) - 1;
+            }
+            if (stop != 0) {
+                const u32 index = std::countr_zero(stop);
+                return s1[index] - s2[index];
+            }
+            if (count <= VectorSize) {
+                return 0;
+            }
+            s1 += VectorSize;
+            s2 += VectorSize;
+            count -= VectorSize;
+            continue;
+        }
 #endif
+        if (*s1 != *s2 || *s1 == 0) {
+            return *s1 - *s2;
+        }
+        s1++;
+        s2++;
+        count--;
+    }
+    return 0;
+}
+
+} // Anonymous namespace
+
+s32 PS4_SYSV_ABI internal_strcpy_s(char* dest, size_t dest_size, const char* src) {
+    if (!dest || dest_size == 0 || dest_size > RsizeMax) {
+        return POSIX_EINVAL;
+    }
+    if (!src) {
+        dest[0] = '\0';
+        return POSIX_EINVAL;
+    }
+    const size_t length = StrNLen(src, dest_size);
+    if (length == dest_size) {
+        dest[0] = '\0';
+        return POSIX_ERANGE;
+    }
+    std::memcpy(dest, src, length + 1);
+    return 0;
+}
+
+s32 PS4_SYSV_ABI internal_strcat_s(char* dest, size_t dest_size, const char* src) {
+    if (!dest || dest_size == 0 || dest_size > RsizeMax) {
+        return POSIX_EINVAL;
+    }
+    if (!src) {
+        dest[0] = '\0';
+        return POSIX_EINVAL;
+    }
+    const size_t dest_length = StrNLen(dest, dest_size);
+    if (dest_length == dest_size) {
+        // Destination is not terminated within its buffer.
+        dest[0] = '\0';
+        return POSIX_EINVAL;
+    }
+    const size_t available = dest_size - dest_length;
+    const size_t length = StrNLen(src, available);
+    if (length == available) {
+        dest[0] = '\0';
+        return POSIX_ERANGE;
+    }
+    std::memcpy(dest + dest_length, src, length + 1);
+    return 0;
 }
 
 s32 PS4_SYSV_ABI internal_strcmp(const char* str1, const char* str2) {
-    return std::strcmp(str1, str2);
+    return StrNCmp(str1, str2, SIZE_MAX);
 }
 
 s32 PS4_SYSV_ABI internal_strncmp(const char* str1, const char* str2, size_t num) {
-    return std::strncmp(str1, str2, num);
+    return StrNCmp(str1, str2, num);
 }
 
 size_t PS4_SYSV_ABI internal_strlen(const char* str) {
-    return std::strlen(str);
+    return StrNLen(str, SIZE_MAX);
+}
+
+size_t PS4_SYSV_ABI internal_strnlen(const char* str, size_t max_len) {
+    return StrNLen(str, max_len);
 }
 
 char* PS4_SYSV_ABI internal_strncpy(char* dest, const char* src, std::size_t count) {
-    return std::strncpy(dest, src, count);
+    const size_t length = StrNLen(src, count);
+    std::memcpy(dest, src, length);
+    std::memset(dest + length, 0, count - length);
+    return dest;
 }
 
 s32 PS4_SYSV_ABI internal_strncpy_s(char* dest, size_t destsz, const char* src, size_t count) {
-#ifdef _WIN64
-    return strncpy_s(dest, destsz, src, count);
-#else
-    std::strcpy(dest, src);
+    if (!dest || destsz == 0 || destsz > RsizeMax || count > RsizeMax) {
+        return POSIX_EINVAL;
+    }
+    if (!src) {
+        dest[0] = '\0';
+        return POSIX_EINVAL;
+    }
+    const size_t length = StrNLen(src, count);
+    if (length >= destsz) {
+        dest[0] = '\0';
+        return POSIX_ERANGE;
+    }
+    std::memcpy(dest, src, length);
+    dest[length] = '\0';
     return 0;
-#endif
 }
 
 char* PS4_SYSV_ABI internal_strcat(char* dest, const char* src) {
-    return std::strcat(dest, src);
+    std::memcpy(dest + StrNLen(dest, SIZE_MAX), src, StrNLen(src, SIZE_MAX) + 1);
+    return dest;
 }
 
 const char* PS4_SYSV_ABI internal_strchr(const char* str, int c) {
@@ -65,12 +202,14 @@ void RegisterlibSceLibcInternalStr(Core::Loader::SymbolsResolver* sym) {
                  internal_strcpy_s);
     LIB_FUNCTION("K+gcnFFJKVc", "libSceLibcInternal", 1, "libSceLibcInternal", 1, 1,
                  internal_strcat_s);
-    LIB_FUNCTION("aesyjrHVWy4", "libSceLibcInternal", 1, "libSceLibcInternal", 1, 1,
-                 internal_strcmp);
     LIB_FUNCTION("Ovb2dSJOAuE", "libSceLibcInternal", 1, "libSceLibcInternal", 1, 1,
+                 internal_strcmp);
+    LIB_FUNCTION("aesyjrHVWy4", "libSceLibcInternal", 1, "libSceLibcInternal", 1, 1,
                  internal_strncmp);
     LIB_FUNCTION("j4ViWNHEgww", "libSceLibcInternal", 1, "libSceLibcInternal", 1, 1,
                  internal_strlen);
+    LIB_FUNCTION("5jNubw4vlAA", "libSceLibcInternal", 1, "libSceLibcInternal", 1, 1,
+                 internal_strnlen);
     LIB_FUNCTION("6sJWiWSRuqk", "libSceLibcInternal", 1, "libSceLibcInternal", 1, 1,
                  internal_strncpy);
     LIB_FUNCTION("YNzNkJzYqEg", "libSceLibcInternal", 1, "libSceLibcInternal", 1, 1,
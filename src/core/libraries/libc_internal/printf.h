@@ -1,762 +1,541 @@
-// SPDX-FileCopyrightText: Copyright 2014-2018 Marco Paland (info@paland.com)
-// SPDX-License-Identifier: MIT
-
-///////////////////////////////////////////////////////////////////////////////
-// \author (c) Marco Paland (info@paland.com)
-//             2014-2018, PALANDesign Hannover, Germany
-//
-// \license The MIT License (MIT)
-//
-// Permission is hereby granted, free of charge, to any person obtaining a copy
-// of this software and associated documentation files (the "Software"), to deal
-// in the Software without restriction, including without limitation the rights
-// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
-// copies of the Software, and to permit persons to whom the Software is
-// furnished to do so, subject to the following conditions:
-//
-// The above copyright notice and this permission notice shall be included in
-// all copies or substantial portions of the Software.
-//
-// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
-// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
-// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
-// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
-// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
-// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
-// THE SOFTWARE.
-//
-// \brief Tiny printf, sprintf and snprintf implementation, optimized for speed on
-//        embedded systems with a very limited resources.
-//        Use this instead of bloated standard/newlib printf.
-//        These routines are thread safe and reentrant!
-//
-///////////////////////////////////////////////////////////////////////////////
-// Vita3K emulator project
-// Copyright (C) 2023 Vita3K team
-//
-// This program is free software; you can redistribute it and/or modify
-// it under the terms of the GNU General Public License as published by
-// the Free Software Foundation; either version 2 of the License, or
-// (at your option) any later version.
-//
-// This program is distributed in the hope that it will be useful,
-// but WITHOUT ANY WARRANTY; without even the implied warranty of
-// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
-// GNU General Public License for more details.
-//
-// You should have received a copy of the GNU General Public License along
-// with this program; if not, write to the Free Software Foundation, Inc.,
-// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
-
-// copied from Vita3k project at 6/10/2023 (latest update 30/06/2023)
-// modifications for adapting va_args parameters
+// SPDX-FileCopyrightText: Copyright 2025 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
 
 #pragma once
 
-#include <stdio.h>
-
-#include <cstdarg>
-#include <cstddef>
-#include <cstdint>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <charconv>
+#include <cmath>
+#include <cstdio>
 #include <cstring>
+#include <limits>
 #include <string>
 
+#include "common/types.h"
 #include "common/va_ctx.h"
 
 namespace Libraries::LibcInternal {
-// ntoa conversion buffer size, this must be big enough to hold
-// one converted numeric number including padded zeros (dynamically created on stack)
-// 32 byte is a good default
-#define PRINTF_NTOA_BUFFER_SIZE 32U
-
-// ftoa conversion buffer size, this must be big enough to hold
-// one converted float number including padded zeros (dynamically created on stack)
-// 32 byte is a good default
-#define PRINTF_FTOA_BUFFER_SIZE 32U
-
-// define this to support floating point (%f)
-#define PRINTF_SUPPORT_FLOAT
-
-// define this to support long long types (%llu or %p)
-#define PRINTF_SUPPORT_LONG_LONG
-
-// define this to support the ptrdiff_t type (%t)
-// ptrdiff_t is normally defined in <stddef.h> as long or long long type
-#define PRINTF_SUPPORT_PTRDIFF_T
-
-///////////////////////////////////////////////////////////////////////////////
-
-// internal flag definitions
-#define FLAGS_ZEROPAD (1U << 0U)
-#define FLAGS_LEFT (1U << 1U)
-#define FLAGS_PLUS (1U << 2U)
-#define FLAGS_SPACE (1U << 3U)
-#define FLAGS_HASH (1U << 4U)
-#define FLAGS_UPPERCASE (1U << 5U)
-#define FLAGS_CHAR (1U << 6U)
-#define FLAGS_SHORT (1U << 7U)
-#define FLAGS_LONG (1U << 8U)
-#define FLAGS_LONG_LONG (1U << 9U)
-#define FLAGS_PRECISION (1U << 10U)
-#define FLAGS_WIDTH (1U << 11U)
-
-// output function type
-typedef void (*out_fct_type)(char character, void* buffer, size_t idx, size_t maxlen);
-
-// wrapper (used as buffer) for output function type
-typedef struct {
-    void (*fct)(char character, void* arg);
-    void* arg;
-} out_fct_wrap_type;
-
-// internal buffer output
-static inline void _out_buffer(char character, void* buffer, size_t idx, size_t maxlen) {
-    if (idx < maxlen) {
-        ((char*)buffer)[idx] = character;
-    }
-}
-
-// internal null output
-static inline void _out_null(char character, void* buffer, size_t idx, size_t maxlen) {
-    (void)character;
-    (void)buffer;
-    (void)idx;
-    (void)maxlen;
-}
-
-// internal output function wrapper
-static inline void _out_fct(char character, void* buffer, size_t idx, size_t maxlen) {
-    (void)idx;
-    (void)maxlen;
-    // buffer is the output fct pointer
-    ((out_fct_wrap_type*)buffer)->fct(character, ((out_fct_wrap_type*)buffer)->arg);
-}
-
-// internal strlen
-// \return The length of the string (excluding the terminating 0)
-static inline unsigned int _strlen(const char* str) {
-    const char* s;
-    for (s = str; *s; ++s)
-        ;
-    return (unsigned int)(s - str);
-}
-
-// internal test if char is a digit (0-9)
-// \return true if char is a digit
-static inline bool _is_digit(char ch) {
-    return (ch >= '0') && (ch <= '9');
-}
-
-// internal ASCII string to unsigned int conversion
-static inline unsigned int _atoi(const char** str) {
-    unsigned int i = 0U;
-    while (_is_digit(**str)) {
-        i = i * 10U + (unsigned int)(*((*str)++) - '0');
-    }
-    return i;
-}
-
-// internal itoa format
-static inline size_t _ntoa_format(out_fct_type out, char* buffer, size_t idx, size_t maxlen,
-                                  char* buf, size_t len, bool negative, unsigned int base,
-                                  unsigned int prec, unsigned int width, unsigned int flags) {
-    const size_t start_idx = idx;
 
-    // pad leading zeros
-    while (!(flags & FLAGS_LEFT) && (len < prec) && (len < PRINTF_NTOA_BUFFER_SIZE)) {
-        buf[len++] = '0';
-    }
-    while (!(flags & FLAGS_LEFT) && (flags & FLAGS_ZEROPAD) && (len < width) &&
-           (len < PRINTF_NTOA_BUFFER_SIZE)) {
-        buf[len++] = '0';
+namespace Printf {
+
+enum Flags : u32 {
+    FlagLeft = 1U << 0,
+    FlagPlus = 1U << 1,
+    FlagSpace = 1U << 2,
+    FlagHash = 1U << 3,
+    FlagZeroPad = 1U << 4,
+    FlagPrecision = 1U << 5,
+    FlagUppercase = 1U << 6,
+};
+
+enum class Length : u32 {
+    Default,
+    Char,
+    Short,
+    Long,
+};
+
+struct Spec {
+    u32 flags = 0;
+    u32 width = 0;
+    u32 precision = 0;
+    Length length = Length::Default;
+};
+
+/// Bounded output buffer. Everything past the capacity is counted but dropped, which is exactly
+/// what the snprintf return value needs.
+class Output {
+public:
+    Output(char* buffer_, size_t capacity_) : buffer{buffer_}, capacity{buffer_ ? capacity_ : 0} {}
+
+    void Append(const char* data, size_t size) {
+        if (pos < capacity) {
+            std::memcpy(buffer + pos, data, std::min(size, capacity - pos));
+        }
+        pos += size;
     }
 
-    // handle hash
-    if (flags & FLAGS_HASH) {
-        if (((len == prec) || (len == width)) && (len > 0U)) {
-            len--;
-            if ((base == 16U) && (len > 0U)) {
-                len--;
-            }
-        }
-        if ((base == 16U) && !(flags & FLAGS_UPPERCASE) && (len < PRINTF_NTOA_BUFFER_SIZE)) {
-            buf[len++] = 'x';
-        }
-        if ((base == 16U) && (flags & FLAGS_UPPERCASE) && (len < PRINTF_NTOA_BUFFER_SIZE)) {
-            buf[len++] = 'X';
-        }
-        if (len < PRINTF_NTOA_BUFFER_SIZE) {
-            buf[len++] = '0';
+    void Fill(char c, size_t count) {
+        if (pos < capacity) {
+            std::memset(buffer + pos, c, std::min(count, capacity - pos));
         }
+        pos += count;
     }
 
-    // handle sign
-    if ((len == width) && (negative || (flags & FLAGS_PLUS) || (flags & FLAGS_SPACE))) {
-        len--;
-    }
-    if (len < PRINTF_NTOA_BUFFER_SIZE) {
-        if (negative) {
-            buf[len++] = '-';
-        } else if (flags & FLAGS_PLUS) {
-            buf[len++] = '+'; // ignore the space if the '+' exists
-        } else if (flags & FLAGS_SPACE) {
-            buf[len++] = ' ';
+    void Put(char c) {
+        if (pos < capacity) {
+            buffer[pos] = c;
         }
+        pos++;
     }
 
-    // pad spaces up to given width
-    if (!(flags & FLAGS_LEFT) && !(flags & FLAGS_ZEROPAD)) {
-        for (size_t i = len; i < width; i++) {
-            out(' ', buffer, idx++, maxlen);
+    void Terminate() {
+        if (capacity != 0) {
+            buffer[std::min(pos, capacity - 1)] = '\0';
         }
     }
 
-    // reverse string
-    for (size_t i = 0U; i < len; i++) {
-        out(buf[len - i - 1U], buffer, idx++, maxlen);
+    size_t Size() const {
+        return pos;
     }
 
-    // append pad spaces up to given width
-    if (flags & FLAGS_LEFT) {
-        while (idx - start_idx < width) {
-            out(' ', buffer, idx++, maxlen);
+private:
+    char* buffer;
+    size_t capacity;
+    size_t pos = 0;
+};
+
+inline constexpr auto DigitPairs = [] {
+    std::array<char, 200> pairs{};
+    for (u32 i = 0; i < 100; i++) {
+        pairs[i * 2] = static_cast<char>('0' + i / 10);
+        pairs[i * 2 + 1] = static_cast<char>('0' + i % 10);
+    }
+    return pairs;
+}();
+
+/// Writes value backwards ending at end and returns the first digit.
+inline char* WriteDigits(char* end, u64 value, u32 base, bool uppercase) {
+    char* p = end;
+    if (base == 10) {
+        while (value >= 100) {
+            p -= 2;
+            std::memcpy(p, &DigitPairs[(value % 100) * 2], 2);
+            value /= 100;
+        }
+        if (value >= 10) {
+            p -= 2;
+            std::memcpy(p, &DigitPairs[value * 2], 2);
+        } else {
+            *--p = static_cast<char>('0' + value);
         }
+        return p;
     }
-
-    return idx;
+    const char* digits = uppercase ? "0123456789ABCDEF" : "0123456789abcdef";
+    const u32 shift = std::countr_zero(base);
+    do {
+        *--p = digits[value & (base - 1)];
+        value >>= shift;
+    } while (value != 0);
+    return p;
 }
 
-// internal itoa for 'long' type
-static inline size_t _ntoa_long(out_fct_type out, char* buffer, size_t idx, size_t maxlen,
-                                unsigned long value, bool negative, unsigned long base,
-                                unsigned int prec, unsigned int width, unsigned int flags) {
-    char buf[PRINTF_NTOA_BUFFER_SIZE];
-    size_t len = 0U;
-
-    // write if precision != 0 and value is != 0
-    if (!(flags & FLAGS_PRECISION) || value) {
-        do {
-            const char digit = (char)(value % base);
-            buf[len++] =
-                digit < 10 ? '0' + digit : (flags & FLAGS_UPPERCASE ? 'A' : 'a') + digit - 10;
-            value /= base;
-        } while (value && (len < PRINTF_NTOA_BUFFER_SIZE));
+/// Emits prefix and body padded to the field width. Zero padding goes between the two.
+inline void Pad(Output& out, const Spec& spec, const char* prefix, size_t prefix_size,
+                size_t zeros, const char* body, size_t body_size, bool allow_zero_pad) {
+    size_t size = prefix_size + zeros + body_size;
+    if (size < spec.width && !(spec.flags & FlagLeft)) {
+        if (allow_zero_pad && (spec.flags & FlagZeroPad)) {
+            zeros += spec.width - size;
+        } else {
+            out.Fill(' ', spec.width - size);
+        }
+        size = spec.width;
     }
-
-    return _ntoa_format(out, buffer, idx, maxlen, buf, len, negative, (unsigned int)base, prec,
-                        width, flags);
-}
-
-// internal itoa for 'long long' type
-#if defined(PRINTF_SUPPORT_LONG_LONG)
-static inline size_t _ntoa_long_long(out_fct_type out, char* buffer, size_t idx, size_t maxlen,
-                                     unsigned long long value, bool negative,
-                                     unsigned long long base, unsigned int prec, unsigned int width,
-                                     unsigned int flags) {
-    char buf[PRINTF_NTOA_BUFFER_SIZE];
-    size_t len = 0U;
-
-    // write if precision != 0 and value is != 0
-    if (!(flags & FLAGS_PRECISION) || value) {
-        do {
-            const char digit = (char)(value % base);
-            buf[len++] =
-                digit < 10 ? '0' + digit : (flags & FLAGS_UPPERCASE ? 'A' : 'a') + digit - 10;
-            value /= base;
-        } while (value && (len < PRINTF_NTOA_BUFFER_SIZE));
+    out.Append(prefix, prefix_size);
+    out.Fill('0', zeros);
+    out.Append(body, body_size);
+    if (size < spec.width) {
+        out.Fill(' ', spec.width - size);
     }
-
-    return _ntoa_format(out, buffer, idx, maxlen, buf, len, negative, (unsigned int)base, prec,
-                        width, flags);
 }
-#endif // PRINTF_SUPPORT_LONG_LONG
-
-#if defined(PRINTF_SUPPORT_FLOAT)
-static inline size_t _ftoa(out_fct_type out, char* buffer, size_t idx, size_t maxlen, double value,
-                           unsigned int prec, unsigned int width, unsigned int flags) {
-    char buf[PRINTF_FTOA_BUFFER_SIZE];
-    size_t len = 0U;
-    double diff = 0.0;
-
-    // if input is larger than thres_max, revert to exponential
-    const double thres_max = (double)0x7FFFFFFF;
-
-    // powers of 10
-    static const double pow10[] = {1,      10,      100,      1000,      10000,
-                                   100000, 1000000, 10000000, 100000000, 1000000000};
-
-    // test for negative
-    bool negative = false;
-    if (value < 0) {
-        negative = true;
-        value = 0 - value;
-    }
 
-    // set default precision to 6, if not set explicitly
-    if (!(flags & FLAGS_PRECISION)) {
-        prec = 6U;
+inline void FormatInteger(Output& out, const Spec& spec, u64 value, bool negative, u32 base) {
+    std::array<char, 64> buffer;
+    char* const end = buffer.data() + buffer.size();
+    char* digits = end;
+    // An explicit zero precision prints nothing for a zero value.
+    if (value != 0 || !(spec.flags & FlagPrecision) || spec.precision != 0) {
+        digits = WriteDigits(end, value, base, spec.flags & FlagUppercase);
     }
-    // limit precision to 9, cause a prec >= 10 can lead to overflow errors
-    while ((len < PRINTF_FTOA_BUFFER_SIZE) && (prec > 9U)) {
-        buf[len++] = '0';
-        prec--;
+    const size_t num_digits = end - digits;
+
+    char prefix[2];
+    size_t prefix_size = 0;
+    if (negative) {
+        prefix[prefix_size++] = '-';
+    } else if (spec.flags & FlagPlus) {
+        prefix[prefix_size++] = '+';
+    } else if (spec.flags & FlagSpace) {
+        prefix[prefix_size++] = ' ';
     }
 
-    int whole = (int)value;
-    double tmp = (value - whole) * pow10[prec];
-    unsigned long frac = (unsigned long)tmp;
-    diff = tmp - frac;
-
-    if (diff > 0.5) {
-        ++frac;
-        // handle rollover, e.g. case 0.99 with prec 1 is 1.0
-        if (frac >= pow10[prec]) {
-            frac = 0;
-            ++whole;
+    size_t zeros = spec.precision > num_digits ? spec.precision - num_digits : 0;
+    if (spec.flags & FlagHash) {
+        if (base == 16 && value != 0) {
+            prefix[prefix_size++] = '0';
+            prefix[prefix_size++] = (spec.flags & FlagUppercase) ? 'X' : 'x';
+        } else if (base == 8 && zeros == 0 && (num_digits == 0 || *digits != '0')) {
+            zeros = 1;
         }
-    } else if ((diff == 0.5) && ((frac == 0U) || (frac & 1U))) {
-        // if halfway, round up if odd, OR if last digit is 0
-        ++frac;
     }
+    Pad(out, spec, prefix, prefix_size, zeros, digits, num_digits,
+        !(spec.flags & FlagPrecision));
+}
 
-    // TBD: for very large numbers switch back to native sprintf for exponentials. Anyone want to
-    // write code to replace this? Normal printf behavior is to print EVERY whole number digit which
-    // can be 100s of characters overflowing your buffers == bad
-    if (value > thres_max) {
-        return 0U;
+inline void FormatFloat(Output& out, const Spec& spec, double value, char conversion) {
+    const bool uppercase = conversion == 'F' || conversion == 'E' || conversion == 'G' ||
+                           conversion == 'A';
+    char prefix[3];
+    size_t prefix_size = 0;
+    if (std::signbit(value)) {
+        prefix[prefix_size++] = '-';
+    } else if (spec.flags & FlagPlus) {
+        prefix[prefix_size++] = '+';
+    } else if (spec.flags & FlagSpace) {
+        prefix[prefix_size++] = ' ';
     }
+    value = std::fabs(value);
 
-    if (prec == 0U) {
-        diff = value - (double)whole;
-        if (diff > 0.5) {
-            // greater than 0.5, round up, e.g. 1.6 -> 2
-            ++whole;
-        } else if ((diff == 0.5) && (whole & 1)) {
-            // exactly 0.5 and ODD, then round up
-            // 1.5 -> 2, but 2.5 -> 2
-            ++whole;
-        }
-    } else {
-        unsigned int count = prec;
-        // now do fractional part, as an unsigned number
-        while (len < PRINTF_FTOA_BUFFER_SIZE) {
-            --count;
-            buf[len++] = (char)(48U + (frac % 10U));
-            if (!(frac /= 10U)) {
-                break;
-            }
-        }
-        // add extra 0s
-        while ((len < PRINTF_FTOA_BUFFER_SIZE) && (count-- > 0U)) {
-            buf[len++] = '0';
-        }
-        if (len < PRINTF_FTOA_BUFFER_SIZE) {
-            // add decimal
-            buf[len++] = '.';
-        }
+    if (!std::isfinite(value)) {
+        const char* text = std::isnan(value) ? (uppercase ? "NAN" : "nan")
+                                             : (uppercase ? "INF" : "inf");
+        Pad(out, spec, prefix, prefix_size, 0, text, 3, false);
+        return;
     }
 
-    // do whole part, number is reversed
-    while (len < PRINTF_FTOA_BUFFER_SIZE) {
-        buf[len++] = (char)(48 + (whole % 10));
-        if (!(whole /= 10)) {
-            break;
+    std::chars_format format;
+    switch (conversion) {
+    case 'f':
+    case 'F':
+        format = std::chars_format::fixed;
+        break;
+    case 'e':
+    case 'E':
+        format = std::chars_format::scientific;
+        break;
+    case 'a':
+    case 'A':
+        format = std::chars_format::hex;
+        prefix[prefix_size++] = '0';
+        prefix[prefix_size++] = uppercase ? 'X' : 'x';
+        break;
+    default:
+        format = std::chars_format::general;
+        break;
+    }
+    const bool has_precision = (spec.flags & FlagPrecision) || format != std::chars_format::hex;
+    int precision = (spec.flags & FlagPrecision) ? spec.precision : 6;
+    if (format == std::chars_format::general && (spec.flags & FlagHash)) {
+        // The alternate %g form keeps trailing zeros, so pick the style the way printf does and
+        // convert with an explicit precision instead of letting to_chars strip them.
+        const int significant = std::max(precision, 1);
+        std::string probe(significant + 16, '\0');
+        const auto probe_end = std::to_chars(probe.data(), probe.data() + probe.size(), value,
+                                             std::chars_format::scientific, significant - 1)
+                                   .ptr;
+        const char* exponent_start = std::find(probe.data(), probe_end, 'e') + 1;
+        int exponent = 0;
+        std::from_chars(exponent_start + (*exponent_start == '+'), probe_end, exponent);
+        if (exponent >= -4 && exponent < significant) {
+            format = std::chars_format::fixed;
+            precision = significant - 1 - exponent;
+        } else {
+            format = std::chars_format::scientific;
+            precision = significant - 1;
         }
     }
-
-    // pad leading zeros
-    while (!(flags & FLAGS_LEFT) && (flags & FLAGS_ZEROPAD) && (len < width) &&
-           (len < PRINTF_FTOA_BUFFER_SIZE)) {
-        buf[len++] = '0';
+    const auto convert = [&](char* first, char* last) {
+        return has_precision ? std::to_chars(first, last, value, format, precision)
+                             : std::to_chars(first, last, value, format);
+    };
+
+    // Fixed notation of large values with a large precision does not fit on the stack.
+    std::array<char, 512> stack_buffer;
+    std::string heap_buffer;
+    char* body = stack_buffer.data();
+    auto result = convert(body, body + stack_buffer.size());
+    if (result.ec != std::errc{}) {
+        heap_buffer.resize(std::numeric_limits<double>::max_exponent10 + precision + 8);
+        body = heap_buffer.data();
+        result = convert(body, body + heap_buffer.size());
     }
+    size_t body_size = result.ptr - body;
 
-    // handle sign
-    if ((len == width) && (negative || (flags & FLAGS_PLUS) || (flags & FLAGS_SPACE))) {
-        len--;
+    if (uppercase) {
+        std::transform(body, body + body_size, body, [](char c) {
+            return c >= 'a' && c <= 'z' ? static_cast<char>(c - 'a' + 'A') : c;
+        });
     }
-    if (len < PRINTF_FTOA_BUFFER_SIZE) {
-        if (negative) {
-            buf[len++] = '-';
-        } else if (flags & FLAGS_PLUS) {
-            buf[len++] = '+'; // ignore the space if the '+' exists
-        } else if (flags & FLAGS_SPACE) {
-            buf[len++] = ' ';
-        }
-    }
-
-    // pad spaces up to given width
-    if (!(flags & FLAGS_LEFT) && !(flags & FLAGS_ZEROPAD)) {
-        for (size_t i = len; i < width; i++) {
-            out(' ', buffer, idx++, maxlen);
+    if ((spec.flags & FlagHash) && !std::memchr(body, '.', body_size)) {
+        // The alternate form always has a radix point, placed before any exponent.
+        const char* exponent = std::find_if(body, body + body_size, [](char c) {
+            return c == 'e' || c == 'E' || c == 'p' || c == 'P';
+        });
+        const size_t point = exponent - body;
+        if (body == stack_buffer.data() && body_size < stack_buffer.size()) {
+            std::memmove(body + point + 1, body + point, body_size - point);
+            body[point] = '.';
+            body_size++;
         }
     }
+    Pad(out, spec, prefix, prefix_size, 0, body, body_size, true);
+}
 
-    // reverse string
-    for (size_t i = 0U; i < len; i++) {
-        out(buf[len - i - 1U], buffer, idx++, maxlen);
+inline void FormatString(Output& out, const Spec& spec, const char* str) {
+    if (!str) {
+        str = "(null)";
     }
-
-    // append pad spaces up to given width
-    if (flags & FLAGS_LEFT) {
-        while (idx < width) {
-            out(' ', buffer, idx++, maxlen);
-        }
+    size_t size;
+    if (spec.flags & FlagPrecision) {
+        const void* end = std::memchr(str, '\0', spec.precision);
+        size = end ? static_cast<const char*>(end) - str : spec.precision;
+    } else {
+        size = std::strlen(str);
     }
-
-    return idx;
+    Pad(out, spec, nullptr, 0, 0, str, size, false);
 }
-#endif // PRINTF_SUPPORT_FLOAT
-
-// internal vsnprintf
-static inline int _vsnprintf(out_fct_type out, char* buffer, const char* format,
-                             Common::VaList* va_list) {
-    unsigned int flags, width, precision, n;
-    size_t idx = 0U;
-    auto maxlen = static_cast<size_t>(-1);
-
-    if (!buffer) {
-        // use null output function
-        out = _out_null;
-    }
 
-    while (*format) {
-        // format specifier?  %[flags][width][.precision][length]
-        if (*format != '%') {
-            // no
-            out(*format, buffer, idx++, maxlen);
-            format++;
-            continue;
-        } else {
-            // yes, evaluate it
-            format++;
+/// Formats into out following the PS4 libc printf rules and returns the untruncated length.
+inline int Format(Output& out, const char* format, Common::VaList* va_list) {
+    while (true) {
+        // Copy the literal run up to the next conversion in one go.
+        const char* percent = std::strchr(format, '%');
+        if (!percent) {
+            out.Append(format, std::strlen(format));
+            break;
         }
+        out.Append(format, percent - format);
+        format = percent + 1;
 
-        // evaluate flags
-        flags = 0U;
-        do {
+        Spec spec;
+        for (bool parsing = true; parsing;) {
             switch (*format) {
-            case '0':
-                flags |= FLAGS_ZEROPAD;
-                format++;
-                n = 1U;
-                break;
             case '-':
-                flags |= FLAGS_LEFT;
-                format++;
-                n = 1U;
+                spec.flags |= FlagLeft;
                 break;
             case '+':
-                flags |= FLAGS_PLUS;
-                format++;
-                n = 1U;
+                spec.flags |= FlagPlus;
                 break;
             case ' ':
-                flags |= FLAGS_SPACE;
-                format++;
-                n = 1U;
+                spec.flags |= FlagSpace;
                 break;
             case '#':
-                flags |= FLAGS_HASH;
-                format++;
-                n = 1U;
+                spec.flags |= FlagHash;
                 break;
-            default:
-                n = 0U;
+            case '0':
+                spec.flags |= FlagZeroPad;
                 break;
+            default:
+                parsing = false;
+                continue;
             }
-        } while (n);
-
-        // evaluate width field
-        width = 0U;
-        if (_is_digit(*format)) {
-            width = _atoi(&format);
-        } else if (*format == '*') {
-            const int w = vaArgInteger(va_list); // const int w = va.next<int>(cpu, mem);
-
-            if (w < 0) {
-                flags |= FLAGS_LEFT; // reverse padding
-                width = (unsigned int)-w;
+            format++;
+        }
+
+        if (*format == '*') {
+            const int width = Common::vaArgInteger(va_list);
+            if (width < 0) {
+                spec.flags |= FlagLeft;
+                spec.width = 0U - static_cast<u32>(width);
             } else {
-                width = (unsigned int)w;
+                spec.width = width;
             }
             format++;
+        } else {
+            while (*format >= '0' && *format <= '9') {
+                spec.width = spec.width * 10 + (*format++ - '0');
+            }
         }
 
-        // evaluate precision field
-        precision = 0U;
         if (*format == '.') {
-            flags |= FLAGS_PRECISION;
             format++;
-            if (_is_digit(*format)) {
-                precision = _atoi(&format);
-            } else if (*format == '*') {
-                precision =
-                    vaArgInteger(va_list); // precision = (unsigned int)va.next<int>(cpu, mem);
+            spec.flags |= FlagPrecision;
+            if (*format == '*') {
+                // A negative precision is taken as if it was omitted.
+                const int precision = Common::vaArgInteger(va_list);
+                if (precision < 0) {
+                    spec.flags &= ~FlagPrecision;
+                } else {
+                    spec.precision = precision;
+                }
                 format++;
+            } else {
+                while (*format >= '0' && *format <= '9') {
+                    spec.precision = spec.precision * 10 + (*format++ - '0');
+                }
             }
         }
 
-        // evaluate length field
+        // The guest is LP64, so every modifier above int selects a 64-bit argument.
         switch (*format) {
-        case 'l':
-            flags |= FLAGS_LONG;
-            format++;
-            if (*format == 'l') {
-                flags |= FLAGS_LONG_LONG;
-                format++;
-            }
-            break;
         case 'h':
-            flags |= FLAGS_SHORT;
             format++;
+            spec.length = Length::Short;
             if (*format == 'h') {
-                flags |= FLAGS_CHAR;
                 format++;
+                spec.length = Length::Char;
             }
             break;
-#if defined(PRINTF_SUPPORT_PTRDIFF_T)
-        case 't':
-            flags |= (sizeof(ptrdiff_t) == sizeof(long) ? FLAGS_LONG : FLAGS_LONG_LONG);
+        case 'l':
             format++;
+            spec.length = Length::Long;
+            if (*format == 'l') {
+                format++;
+            }
             break;
-#endif
         case 'j':
-            flags |= (sizeof(intmax_t) == sizeof(long) ? FLAGS_LONG : FLAGS_LONG_LONG);
-            format++;
-            break;
         case 'z':
-            flags |= (sizeof(size_t) == sizeof(long) ? FLAGS_LONG : FLAGS_LONG_LONG);
+        case 't':
+        case 'q':
+        case 'L':
             format++;
+            spec.length = Length::Long;
             break;
         default:
             break;
         }
 
-        // evaluate specifier
-        switch (*format) {
+        const char conversion = *format;
+        if (conversion == '\0') {
+            break;
+        }
+        format++;
+        switch (conversion) {
         case 'd':
-        case 'i':
+        case 'i': {
+            s64 value;
+            switch (spec.length) {
+            case Length::Char:
+                value = static_cast<s8>(Common::vaArgInteger(va_list));
+                break;
+            case Length::Short:
+                value = static_cast<s16>(Common::vaArgInteger(va_list));
+                break;
+            case Length::Long:
+                value = Common::vaArgLongLong(va_list);
+                break;
+            default:
+                value = Common::vaArgInteger(va_list);
+                break;
+            }
+            const u64 magnitude = value < 0 ? 0ULL - static_cast<u64>(value) : value;
+            FormatInteger(out, spec, magnitude, value < 0, 10);
+            break;
+        }
         case 'u':
         case 'x':
         case 'X':
         case 'o':
         case 'b': {
-            // set the base
-            unsigned int base;
-            if (*format == 'x' || *format == 'X') {
-                base = 16U;
-            } else if (*format == 'o') {
-                base = 8U;
-            } else if (*format == 'b') {
-                base = 2U;
-                flags &= ~FLAGS_HASH; // no hash for bin format
-            } else {
-                base = 10U;
-                flags &= ~FLAGS_HASH; // no hash for dec format
-            }
-            // uppercase
-            if (*format == 'X') {
-                flags |= FLAGS_UPPERCASE;
-            }
-
-            // no plus or space flag for u, x, X, o, b
-            if ((*format != 'i') && (*format != 'd')) {
-                flags &= ~(FLAGS_PLUS | FLAGS_SPACE);
+            u64 value;
+            switch (spec.length) {
+            case Length::Char:
+                value = static_cast<u8>(Common::vaArgInteger(va_list));
+                break;
+            case Length::Short:
+                value = static_cast<u16>(Common::vaArgInteger(va_list));
+                break;
+            case Length::Long:
+                value = Common::vaArgLongLong(va_list);
+                break;
+            default:
+                value = static_cast<u32>(Common::vaArgInteger(va_list));
+                break;
             }
-
-            // convert the integer
-            if ((*format == 'i') || (*format == 'd')) {
-                // signed
-                if (flags & FLAGS_LONG_LONG) {
-#if defined(PRINTF_SUPPORT_LONG_LONG)
-                    auto value = vaArgLongLong(
-                        va_list); // const long long value = va.next<long long>(cpu, mem);
-                    idx = _ntoa_long_long(out, buffer, idx, maxlen,
-                                          (unsigned long long)(value > 0 ? value : 0 - value),
-                                          value < 0, base, precision, width, flags);
-#endif
-                } else if (flags & FLAGS_LONG) {
-                    auto value = vaArgLong(va_list); // const long value = va.next<long>(cpu, mem);
-                    idx = _ntoa_long(out, buffer, idx, maxlen,
-                                     (unsigned long)(value > 0 ? value : 0 - value), value < 0,
-                                     base, precision, width, flags);
-                } else {
-                    // const int value = (flags & FLAGS_CHAR) ? (char)va.next<int>(cpu, mem) :
-                    // (flags & FLAGS_SHORT) ? (short int)va.next<int>(cpu, mem): va.next<int>(cpu,
-                    // mem);
-                    const int value =
-                        (flags & FLAGS_CHAR)    ? static_cast<char>(vaArgInteger(va_list))
-                        : (flags & FLAGS_SHORT) ? static_cast<int16_t>(vaArgInteger(va_list))
-                                                : vaArgInteger(va_list);
-                    idx = _ntoa_long(out, buffer, idx, maxlen,
-                                     (unsigned int)(value > 0 ? value : 0 - value), value < 0, base,
-                                     precision, width, flags);
-                }
-            } else {
-                // unsigned
-                if (flags & FLAGS_LONG_LONG) {
-#if defined(PRINTF_SUPPORT_LONG_LONG)
-                    // idx = _ntoa_long_long(out, buffer, idx, maxlen, va.next<unsigned long
-                    // long>(cpu, mem), false, base, precision, width, flags);
-                    idx = _ntoa_long_long(out, buffer, idx, maxlen,
-                                          static_cast<u64>(vaArgLongLong(va_list)), false, base,
-                                          precision, width, flags);
-#endif
-                } else if (flags & FLAGS_LONG) {
-                    // idx = _ntoa_long(out, buffer, idx, maxlen, va.next<unsigned long>(cpu, mem),
-                    // false, base, precision, width, flags);
-                    idx = _ntoa_long(out, buffer, idx, maxlen, static_cast<u32>(vaArgLong(va_list)),
-                                     false, base, precision, width, flags);
-                } else {
-                    // const unsigned int value = (flags & FLAGS_CHAR) ? (unsigned
-                    // char)va.next<unsigned int>(cpu, mem) : (flags & FLAGS_SHORT) ?
-                    //     (unsigned short int)va.next<unsigned int>(cpu, mem) : va.next<unsigned
-                    //     int>(cpu, mem);
-                    const unsigned int value =
-                        (flags & FLAGS_CHAR)    ? static_cast<u8>(vaArgInteger(va_list))
-                        : (flags & FLAGS_SHORT) ? static_cast<u16>(vaArgInteger(va_list))
-                                                : static_cast<u32>(vaArgInteger(va_list));
-                    idx = _ntoa_long(out, buffer, idx, maxlen, value, false, base, precision, width,
-                                     flags);
-                }
+            spec.flags &= ~(FlagPlus | FlagSpace);
+            if (conversion == 'X') {
+                spec.flags |= FlagUppercase;
             }
-            format++;
+            const u32 base = conversion == 'u'   ? 10
+                             : conversion == 'o' ? 8
+                             : conversion == 'b' ? 2
+                                                 : 16;
+            FormatInteger(out, spec, value, false, base);
             break;
         }
-#if defined(PRINTF_SUPPORT_FLOAT)
         case 'f':
         case 'F':
-            // idx = _ftoa(out, buffer, idx, maxlen, va.next<double>(cpu, mem), precision, width,
-            // flags);
-            idx = _ftoa(out, buffer, idx, maxlen, vaArgDouble(va_list), precision, width, flags);
-            format++;
+        case 'e':
+        case 'E':
+        case 'g':
+        case 'G':
+        case 'a':
+        case 'A':
+            FormatFloat(out, spec, Common::vaArgDouble(va_list), conversion);
             break;
-#endif // PRINTF_SUPPORT_FLOAT
         case 'c': {
-            unsigned int l = 1U;
-            // pre padding
-            if (!(flags & FLAGS_LEFT)) {
-                while (l++ < width) {
-                    out(' ', buffer, idx++, maxlen);
-                }
-            }
-            // char output
-            // out((char)va.next<int>(cpu, mem), buffer, idx++, maxlen);
-            out(static_cast<char>(vaArgInteger(va_list)), buffer, idx++, maxlen);
-            // post padding
-            if (flags & FLAGS_LEFT) {
-                while (l++ < width) {
-                    out(' ', buffer, idx++, maxlen);
-                }
-            }
-            format++;
+            const char c = static_cast<char>(Common::vaArgInteger(va_list));
+            Pad(out, spec, nullptr, 0, 0, &c, 1, false);
             break;
         }
-
-        case 's': {
-            const char* p = vaArgPtr<const char>(
-                va_list); // const char *p = va.next<Ptr<char>>(cpu, mem).get(mem);
-            p = p != nullptr ? p : "(null)";
-            unsigned int l = _strlen(p);
-            // pre padding
-            if (flags & FLAGS_PRECISION) {
-                l = (l < precision ? l : precision);
-            }
-            if (!(flags & FLAGS_LEFT)) {
-                while (l++ < width) {
-                    out(' ', buffer, idx++, maxlen);
-                }
-            }
-            // string output
-            while ((*p != 0) && (!(flags & FLAGS_PRECISION) || precision--)) {
-                out(*(p++), buffer, idx++, maxlen);
-            }
-            // post padding
-            if (flags & FLAGS_LEFT) {
-                while (l++ < width) {
-                    out(' ', buffer, idx++, maxlen);
-                }
-            }
-            format++;
+        case 's':
+            FormatString(out, spec, Common::vaArgPtr<const char>(va_list));
             break;
-        }
-
-        case 'p': {
-            width = sizeof(void*) * 2U;
-            flags |= FLAGS_ZEROPAD | FLAGS_UPPERCASE;
-#if defined(PRINTF_SUPPORT_LONG_LONG)
-            const bool is_ll = sizeof(uintptr_t) == sizeof(long long);
-            if (is_ll) {
-                // idx = _ntoa_long_long(out, buffer, idx, maxlen,
-                // (uintptr_t)va.next<Ptr<void>>(cpu, mem).address(), false, 16U, precision, width,
-                // flags);
-                idx = _ntoa_long_long(out, buffer, idx, maxlen,
-                                      reinterpret_cast<uintptr_t>(vaArgPtr<void>(va_list)), false,
-                                      16U, precision, width, flags);
-            } else {
-#endif
-                // idx = _ntoa_long(out, buffer, idx, maxlen, (unsigned
-                // long)((uintptr_t)va.next<Ptr<void>>(cpu, mem).address()), false, 16U, precision,
-                // width, flags);
-                idx = _ntoa_long(
-                    out, buffer, idx, maxlen,
-                    static_cast<uint32_t>(reinterpret_cast<uintptr_t>(vaArgPtr<void>(va_list))),
-                    false, 16U, precision, width, flags);
-#if defined(PRINTF_SUPPORT_LONG_LONG)
+        case 'p':
+            // Pointers print as 16 upper case hex digits without a prefix.
+            spec.flags = (spec.flags & FlagLeft) | FlagZeroPad | FlagUppercase;
+            spec.width = std::max<u32>(spec.width, sizeof(u64) * 2);
+            FormatInteger(out, spec, reinterpret_cast<uintptr_t>(Common::vaArgPtr<void>(va_list)),
+                          false, 16);
+            break;
+        case 'n': {
+            void* ptr = Common::vaArgPtr<void>(va_list);
+            const u64 count = out.Size();
+            switch (spec.length) {
+            case Length::Char:
+                *static_cast<s8*>(ptr) = static_cast<s8>(count);
+                break;
+            case Length::Short:
+                *static_cast<s16*>(ptr) = static_cast<s16>(count);
+                break;
+            case Length::Long:
+                *static_cast<s64*>(ptr) = static_cast<s64>(count);
+                break;
+            default:
+                *static_cast<s32*>(ptr) = static_cast<s32>(count);
+                break;
             }
-#endif
-            format++;
             break;
         }
-
-        case '%':
-            out('%', buffer, idx++, maxlen);
-            format++;
-            break;
-
         default:
-            out(*format, buffer, idx++, maxlen);
-            format++;
+            // Covers %% as well as unknown conversions, which print the character itself.
+            out.Put(conversion);
             break;
         }
     }
 
-    // termination
-    out((char)0, buffer, idx < maxlen ? idx : maxlen - 1U, maxlen);
-
-    // return written chars without terminating \0
-    return (int)idx;
+    out.Terminate();
+    return static_cast<int>(out.Size());
 }
 
+} // namespace Printf
+
 static int printf_ctx(Common::VaCtx* ctx) {
-    const char* format = vaArgPtr<const char>(&ctx->va_list);
-    char buffer[256];
-    int result = _vsnprintf(_out_buffer, buffer, format, &ctx->va_list);
-    printf("%s", buffer);
+    const char* format = Common::vaArgPtr<const char>(&ctx->va_list);
+    std::array<char, 512> buffer;
+    Common::VaList args = ctx->va_list;
+    Printf::Output out{buffer.data(), buffer.size()};
+    const int result = Printf::Format(out, format, &args);
+    if (static_cast<size_t>(result) < buffer.size()) {
+        std::fwrite(buffer.data(), 1, result, stdout);
+        return result;
+    }
+    // Too long for the stack buffer, format again from the start of the arguments.
+    std::string large(result + 1, '\0');
+    Printf::Output large_out{large.data(), large.size()};
+    Printf::Format(large_out, format, &ctx->va_list);
+    std::fwrite(large.data(), 1, result, stdout);
     return result;
 }
 
 static int fprintf_ctx(Common::VaCtx* ctx, char* buf) {
-    const char* format = vaArgPtr<const char>(&ctx->va_list);
-    char buffer[256];
-    int result = _vsnprintf(_out_buffer, buffer, format, &ctx->va_list);
-    std::strcpy(buf, buffer);
-    return result;
+    const char* format = Common::vaArgPtr<const char>(&ctx->va_list);
+    Printf::Output out{buf, SIZE_MAX};
+    return Printf::Format(out, format, &ctx->va_list);
 }
 
 static int vsnprintf_ctx(char* s, size_t n, const char* format, Common::VaList* arg) {
-    char buffer[n];
-    int result = _vsnprintf(_out_buffer, buffer, format, arg);
-    std::strcpy(s, buffer);
-    return result;
+    Printf::Output out{s, n};
+    return Printf::Format(out, format, arg);
 }
 
 static int snprintf_ctx(char* s, size_t n, Common::VaCtx* ctx) {
-    const char* format = vaArgPtr<const char>(&ctx->va_list);
-    char buffer[n];
-    int result = _vsnprintf(_out_buffer, buffer, format, &ctx->va_list);
-    std::strcpy(s, buffer);
-    return result;
+    const char* format = Common::vaArgPtr<const char>(&ctx->va_list);
+    Printf::Output out{s, n};
+    return Printf::Format(out, format, &ctx->va_list);
 }
 
-} // namespace Libraries::LibcInternal
\ No newline at end of file
+} // namespace Libraries::LibcInternal
@@ -1,7 +1,10 @@
 // SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <csetjmp>
+#include <cstdlib>
 #include <png.h>
+#include "common/alignment.h"
 #include "common/assert.h"
 #include "common/logging/log.h"
 #include "core/libraries/libpng/pngdec.h"
@@ -10,9 +13,18 @@
 
 namespace Libraries::PngDec {
 
+/// Bump allocator over the work memory the guest passed to scePngDecCreate. Every decode starts
+/// from an empty arena, so libpng's inflate window and row buffers reuse the same memory instead
+/// of going through the host heap. Allocations that do not fit fall back to malloc.
+struct PngArena {
+    u8* base;
+    size_t size;
+    size_t used;
+};
+
 struct PngHandler {
-    png_structp png_ptr;
-    png_infop info_ptr;
+    PngArena arena;
+    u32 max_image_width;
 };
 
 struct PngStruct {
@@ -21,6 +33,40 @@ struct PngStruct {
     u64 offset;
 };
 
+/// Work memory reserved for libpng and the zlib inflate state on top of the row buffers.
+static constexpr size_t PngDecBaseWorkSize = 128_KB;
+/// libpng keeps a current and a previous row, each at most 8 bytes per pixel plus a filter byte.
+static constexpr size_t PngDecRowBuffers = 2;
+static constexpr size_t PngDecMaxPixelSize = 8;
+
+static png_voidp PngArenaAlloc(png_structp png_ptr, png_alloc_size_t size) {
+    auto* arena = static_cast<PngArena*>(png_get_mem_ptr(png_ptr));
+    const size_t aligned_size = Common::AlignUp(size, 16);
+    if (arena->size - arena->used < aligned_size) {
+        return std::malloc(size);
+    }
+    void* ptr = arena->base + arena->used;
+    arena->used += aligned_size;
+    return ptr;
+}
+
+static void PngArenaFree(png_structp png_ptr, png_voidp ptr) {
+    const auto* arena = static_cast<PngArena*>(png_get_mem_ptr(png_ptr));
+    const auto* bytes = static_cast<const u8*>(ptr);
+    if (bytes < arena->base || bytes >= arena->base + arena->size) {
+        std::free(ptr);
+    }
+}
+
+static void PngReadData(png_structp png_ptr, png_bytep data, png_size_t length) {
+    auto* pngdata = static_cast<PngStruct*>(png_get_io_ptr(png_ptr));
+    if (length > pngdata->size - pngdata->offset) {
+        png_error(png_ptr, "read past the end of the png data");
+    }
+    std::memcpy(data, pngdata->data + pngdata->offset, length);
+    pngdata->offset += length;
+}
+
 static inline OrbisPngDecColorSpace MapPngColor(int color) {
     switch (color) {
     case PNG_COLOR_TYPE_GRAY:
@@ -39,6 +85,7 @@ static inline OrbisPngDecColorSpace MapPngColor(int color) {
 
 void PngDecError(png_structp png_ptr, png_const_charp error_message) {
     LOG_ERROR(Lib_Png, "PNG error {}", error_message);
+    png_longjmp(png_ptr, 1);
 }
 
 void PngDecWarning(png_structp png_ptr, png_const_charp error_message) {
@@ -59,19 +106,21 @@ s32 PS4_SYSV_ABI scePngDecCreate(const OrbisPngDecCreateParam* param, void* memo
         LOG_ERROR(Lib_Png, "Invalid size! width = {}", param->max_image_width);
         return ORBIS_PNG_DEC_ERROR_INVALID_SIZE;
     }
-    auto pngh = (PngHandler*)memoryAddress;
-
-    pngh->png_ptr =
-        png_create_read_struct(PNG_LIBPNG_VER_STRING, nullptr, PngDecError, PngDecWarning);
-
-    if (pngh->png_ptr == nullptr)
-        return ORBIS_PNG_DEC_ERROR_FATAL;
-
-    pngh->info_ptr = png_create_info_struct(pngh->png_ptr);
-    if (pngh->info_ptr == nullptr) {
-        png_destroy_read_struct(&pngh->png_ptr, nullptr, nullptr);
-        return false;
+    if (memorySize < sizeof(PngHandler)) {
+        LOG_ERROR(Lib_Png, "Work memory too small! size = {}", memorySize);
+        return ORBIS_PNG_DEC_ERROR_INVALID_WORK_MEMORY;
     }
+    auto* pngh = static_cast<PngHandler*>(memoryAddress);
+    auto* const memory = static_cast<u8*>(memoryAddress);
+    auto* const arena_base = reinterpret_cast<u8*>(
+        Common::AlignUp(reinterpret_cast<uintptr_t>(memory + sizeof(PngHandler)), 16));
+    const size_t arena_offset = arena_base - memory;
+    pngh->arena = PngArena{
+        .base = arena_base,
+        .size = memorySize > arena_offset ? memorySize - arena_offset : 0,
+        .used = 0,
+    };
+    pngh->max_image_width = param->max_image_width;
 
     *handle = pngh;
     return ORBIS_OK;
@@ -97,27 +146,47 @@ s32 PS4_SYSV_ABI scePngDecDecode(OrbisPngDecHandle handle, const OrbisPngDecDeco
               param->png_mem_size, param->image_mem_size, int(param->pixel_format),
               param->alpha_value, param->image_pitch);
 
-    auto pngh = (PngHandler*)handle;
+    auto* pngh = static_cast<PngHandler*>(handle);
+    pngh->arena.used = 0;
+    png_structp png_ptr =
+        png_create_read_struct_2(PNG_LIBPNG_VER_STRING, nullptr, PngDecError, PngDecWarning,
+                                 &pngh->arena, PngArenaAlloc, PngArenaFree);
+    if (png_ptr == nullptr) {
+        return ORBIS_PNG_DEC_ERROR_FATAL;
+    }
+    png_infop info_ptr = png_create_info_struct(png_ptr);
+    if (info_ptr == nullptr) {
+        png_destroy_read_struct(&png_ptr, nullptr, nullptr);
+        return ORBIS_PNG_DEC_ERROR_FATAL;
+    }
 
-    const auto pngdata = PngStruct{
+    auto pngdata = PngStruct{
         .data = param->png_mem_addr,
         .size = param->png_mem_size,
         .offset = 0,
     };
-    png_set_read_fn(pngh->png_ptr, (void*)&pngdata,
-                    [](png_structp ps, png_bytep data, png_size_t len) {
-                        if (len == 0)
-                            return;
-                        auto pngdata = (PngStruct*)png_get_io_ptr(ps);
-                        ::memcpy(data, pngdata->data + pngdata->offset, len);
-                        pngdata->offset += len;
-                    });
-
-    png_read_info(pngh->png_ptr, pngh->info_ptr);
-    const u32 width = png_get_image_width(pngh->png_ptr, pngh->info_ptr);
-    const u32 height = png_get_image_height(pngh->png_ptr, pngh->info_ptr);
-    const auto color_type = MapPngColor(png_get_color_type(pngh->png_ptr, pngh->info_ptr));
-    const auto bit_depth = png_get_bit_depth(pngh->png_ptr, pngh->info_ptr);
+    if (setjmp(png_jmpbuf(png_ptr))) {
+        png_destroy_read_struct(&png_ptr, &info_ptr, nullptr);
+        return ORBIS_PNG_DEC_ERROR_DECODE_ERROR;
+    }
+    png_set_read_fn(png_ptr, &pngdata, PngReadData);
+    // Guest assets are trusted, skip the per chunk CRC and zlib checksum work.
+    png_set_crc_action(png_ptr, PNG_CRC_QUIET_USE, PNG_CRC_QUIET_USE);
+#ifdef PNG_IGNORE_ADLER32
+    png_set_option(png_ptr, PNG_IGNORE_ADLER32, PNG_OPTION_ON);
+#endif
+
+    png_read_info(png_ptr, info_ptr);
+    const u32 width = png_get_image_width(png_ptr, info_ptr);
+    const u32 height = png_get_image_height(png_ptr, info_ptr);
+    const auto color_type = MapPngColor(png_get_color_type(png_ptr, info_ptr));
+    const auto bit_depth = png_get_bit_depth(png_ptr, info_ptr);
+    if (width > pngh->max_image_width) {
+        LOG_ERROR(Lib_Png, "Image width {} exceeds the handle maximum {}", width,
+                  pngh->max_image_width);
+        png_destroy_read_struct(&png_ptr, &info_ptr, nullptr);
+        return ORBIS_PNG_DEC_ERROR_INVALID_SIZE;
+    }
 
     if (imageInfo != nullptr) {
         imageInfo->bit_depth = bit_depth;
@@ -125,53 +194,62 @@ s32 PS4_SYSV_ABI scePngDecDecode(OrbisPngDecHandle handle, const OrbisPngDecDeco
         imageInfo->image_height = height;
         imageInfo->color_space = color_type;
         imageInfo->image_flag = OrbisPngDecImageFlag::None;
-        if (png_get_interlace_type(pngh->png_ptr, pngh->info_ptr) == 1) {
+        if (png_get_interlace_type(png_ptr, info_ptr) == 1) {
             imageInfo->image_flag |= OrbisPngDecImageFlag::Adam7Interlace;
         }
-        if (png_get_valid(pngh->png_ptr, pngh->info_ptr, PNG_INFO_tRNS)) {
+        if (png_get_valid(png_ptr, info_ptr, PNG_INFO_tRNS)) {
             imageInfo->image_flag |= OrbisPngDecImageFlag::TrnsChunkExist;
         }
     }
 
     if (bit_depth == 16) {
-        png_set_strip_16(pngh->png_ptr);
+        png_set_strip_16(png_ptr);
     }
     if (color_type == OrbisPngDecColorSpace::Clut) {
-        png_set_palette_to_rgb(pngh->png_ptr);
+        png_set_palette_to_rgb(png_ptr);
     }
     if (color_type == OrbisPngDecColorSpace::Grayscale && bit_depth < 8) {
-        png_set_expand_gray_1_2_4_to_8(pngh->png_ptr);
+        png_set_expand_gray_1_2_4_to_8(png_ptr);
     }
-    if (png_get_valid(pngh->png_ptr, pngh->info_ptr, PNG_INFO_tRNS)) {
-        png_set_tRNS_to_alpha(pngh->png_ptr);
+    if (png_get_valid(png_ptr, info_ptr, PNG_INFO_tRNS)) {
+        png_set_tRNS_to_alpha(png_ptr);
     }
     if (color_type == OrbisPngDecColorSpace::Grayscale ||
         color_type == OrbisPngDecColorSpace::GrayscaleAlpha) {
-        png_set_gray_to_rgb(pngh->png_ptr);
+        png_set_gray_to_rgb(png_ptr);
     }
     if (param->pixel_format == OrbisPngDecPixelFormat::B8G8R8A8) {
-        png_set_bgr(pngh->png_ptr);
+        png_set_bgr(png_ptr);
     }
     if (color_type == OrbisPngDecColorSpace::Rgb ||
         color_type == OrbisPngDecColorSpace::Grayscale ||
         color_type == OrbisPngDecColorSpace::Clut) {
-        png_set_add_alpha(pngh->png_ptr, param->alpha_value, PNG_FILLER_AFTER);
+        png_set_add_alpha(png_ptr, param->alpha_value, PNG_FILLER_AFTER);
     }
 
-    const s32 pass = png_set_interlace_handling(pngh->png_ptr);
-    png_read_update_info(pngh->png_ptr, pngh->info_ptr);
+    const s32 pass = png_set_interlace_handling(png_ptr);
+    png_read_update_info(png_ptr, info_ptr);
 
-    const s32 num_channels = png_get_channels(pngh->png_ptr, pngh->info_ptr);
-    const s32 horizontal_bytes = num_channels * width;
-    const s32 stride = param->image_pitch > 0 ? param->image_pitch : horizontal_bytes;
+    const u32 num_channels = png_get_channels(png_ptr, info_ptr);
+    const u64 horizontal_bytes = num_channels * width;
+    const u64 stride = param->image_pitch > 0 ? param->image_pitch : horizontal_bytes;
+    if (height > 0 && stride * (height - 1) + horizontal_bytes > param->image_mem_size) {
+        LOG_ERROR(Lib_Png, "Image memory too small! size = {}, needed = {}",
+                  param->image_mem_size, stride * (height - 1) + horizontal_bytes);
+        png_destroy_read_struct(&png_ptr, &info_ptr, nullptr);
+        return ORBIS_PNG_DEC_ERROR_INVALID_SIZE;
+    }
 
-    for (int j = 0; j < pass; j++) {
+    // Rows are decoded and converted straight into guest memory, interlaced images revisit them
+    // once per pass.
+    for (s32 j = 0; j < pass; j++) {
         auto ptr = reinterpret_cast<png_bytep>(param->image_mem_addr);
-        for (int y = 0; y < height; y++) {
-            png_read_row(pngh->png_ptr, ptr, nullptr);
+        for (u32 y = 0; y < height; y++) {
+            png_read_row(png_ptr, ptr, nullptr);
             ptr += stride;
         }
     }
+    png_destroy_read_struct(&png_ptr, &info_ptr, nullptr);
 
     return (width > 32767 || height > 32767) ? 0 : (width << 16) | height;
 }
@@ -182,8 +260,11 @@ s32 PS4_SYSV_ABI scePngDecDecodeWithInputControl() {
 }
 
 s32 PS4_SYSV_ABI scePngDecDelete(OrbisPngDecHandle handle) {
-    auto pngh = *(PngHandler**)handle;
-    png_destroy_read_struct(&pngh->png_ptr, &pngh->info_ptr, nullptr);
+    if (handle == nullptr) {
+        LOG_ERROR(Lib_Png, "invalid handle!");
+        return ORBIS_PNG_DEC_ERROR_INVALID_HANDLE;
+    }
+    // Decoder state only lives for the duration of a decode, the work memory belongs to the guest.
     return ORBIS_OK;
 }
 
@@ -208,17 +289,16 @@ s32 PS4_SYSV_ABI scePngDecParseHeader(const OrbisPngDecParseParam* param,
     // Create a libpng info structure
     auto info_ptr = png_create_info_struct(png_ptr);
 
-    const auto pngdata = PngStruct{
+    auto pngdata = PngStruct{
         .data = param->png_mem_addr,
         .size = param->png_mem_size,
         .offset = 0,
     };
-
-    png_set_read_fn(png_ptr, (void*)&pngdata, [](png_structp ps, png_bytep data, png_size_t len) {
-        auto pngdata = (PngStruct*)png_get_io_ptr(ps);
-        ::memcpy(data, pngdata->data + pngdata->offset, len);
-        pngdata->offset += len;
-    });
+    if (setjmp(png_jmpbuf(png_ptr))) {
+        png_destroy_read_struct(&png_ptr, &info_ptr, nullptr);
+        return ORBIS_PNG_DEC_ERROR_INVALID_DATA;
+    }
+    png_set_read_fn(png_ptr, &pngdata, PngReadData);
 
     // Now call png_read_info with our pngPtr as image handle, and infoPtr to receive the file
     // info.
@@ -258,7 +338,9 @@ s32 PS4_SYSV_ABI scePngDecQueryMemorySize(const OrbisPngDecCreateParam* param) {
         LOG_ERROR(Lib_Png, "Invalid size! width = {}", param->max_image_width);
         return ORBIS_PNG_DEC_ERROR_INVALID_SIZE;
     }
-    return sizeof(PngHandler);
+    const size_t row_size = PngDecMaxPixelSize * param->max_image_width + 1;
+    return static_cast<s32>(sizeof(PngHandler) + 16 + PngDecBaseWorkSize +
+                            PngDecRowBuffers * Common::AlignUp(row_size, 16));
 }
 
 void RegisterlibScePngDec(Core::Loader::SymbolsResolver* sym) {
@@ -1,16 +1,115 @@
 // SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <vector>
+
 #include "common/logging/log.h"
+#include "common/singleton.h"
 #include "core/libraries/error_codes.h"
 #include "core/libraries/libs.h"
 #include "core/libraries/network/http.h"
+#include "core/libraries/network/http_client.h"
 #include "http_error.h"
 
 namespace Libraries::Http {
 
-int PS4_SYSV_ABI sceHttpAbortRequest() {
-    LOG_ERROR(Lib_Http, "(STUBBED) called");
+namespace {
+
+constexpr std::array<const char*, 8> MethodNames = {
+    "GET", "POST", "HEAD", "OPTIONS", "PUT", "DELETE", "TRACE", "CONNECT",
+};
+
+struct ParsedUrl {
+    std::string scheme;
+    std::string host;
+    std::string path;
+    u16 port;
+};
+
+int ParseUrl(const char* url, ParsedUrl& parsed) {
+    if (!url) {
+        return ORBIS_HTTP_ERROR_INVALID_URL;
+    }
+    size_t require = 0;
+    if (const int result = sceHttpUriParse(nullptr, url, nullptr, &require, 0); result < 0) {
+        return result;
+    }
+    std::vector<char> pool(require);
+    OrbisHttpUriElement element{};
+    if (const int result = sceHttpUriParse(&element, url, pool.data(), nullptr, pool.size());
+        result < 0) {
+        return result;
+    }
+    if (!element.scheme || !element.hostname || element.hostname[0] == '\0') {
+        return ORBIS_HTTP_ERROR_INVALID_URL;
+    }
+    parsed.scheme = element.scheme;
+    parsed.host = element.hostname;
+    parsed.path = element.path ? element.path : "/";
+    if (element.query) {
+        parsed.path += '?';
+        parsed.path += element.query;
+    }
+    parsed.port = element.port;
+    return ORBIS_OK;
+}
+
+int CreateConnection(const HttpTemplatePtr& tmpl, const std::string& host,
+                     const std::string& scheme, u16 port, bool keep_alive) {
+    auto conn = std::make_shared<HttpConnection>();
+    static_cast<HttpSettings&>(*conn) = *tmpl;
+    conn->tmpl = tmpl;
+    conn->scheme = scheme;
+    conn->host = host;
+    conn->port = port != 0 ? port : (scheme == "https" ? 443 : 80);
+    conn->keep_alive = keep_alive;
+    return Common::Singleton<HttpInternal>::Instance()->AddConnection(std::move(conn));
+}
+
+int CreateRequest(int conn_id, const char* method, const char* path, u64 content_length) {
+    auto* http = Common::Singleton<HttpInternal>::Instance();
+    auto conn = http->FindConnection(conn_id);
+    if (!conn) {
+        return ORBIS_HTTP_ERROR_INVALID_ID;
+    }
+    if (!path) {
+        return ORBIS_HTTP_ERROR_INVALID_VALUE;
+    }
+    auto req = std::make_shared<HttpRequest>();
+    static_cast<HttpSettings&>(*req) = *conn;
+    req->connection = std::move(conn);
+    req->method = method;
+    req->path = path;
+    req->content_length = content_length;
+    return http->AddRequest(std::move(req));
+}
+
+/// Makes sure the response header is available, which may still be pending in non-blocking mode.
+int CheckResponse(const HttpRequest& req) {
+    switch (req.state.load(std::memory_order_acquire)) {
+    case HttpRequest::State::Idle:
+        return ORBIS_HTTP_ERROR_BEFORE_SEND;
+    case HttpRequest::State::Sending:
+        return ORBIS_HTTP_ERROR_EAGAIN;
+    case HttpRequest::State::Error:
+        return req.error;
+    default:
+        return ORBIS_OK;
+    }
+}
+
+} // Anonymous namespace
+
+int PS4_SYSV_ABI sceHttpAbortRequest(int reqId) {
+    LOG_DEBUG(Lib_Http, "called reqId = {}", reqId);
+    auto req = Common::Singleton<HttpInternal>::Instance()->FindRequest(reqId);
+    if (!req) {
+        return ORBIS_HTTP_ERROR_INVALID_ID;
+    }
+    req->Abort();
     return ORBIS_OK;
 }
 
@@ -34,8 +133,24 @@ int PS4_SYSV_ABI sceHttpAddQuery() {
     return ORBIS_OK;
 }
 
-int PS4_SYSV_ABI sceHttpAddRequestHeader() {
-    LOG_ERROR(Lib_Http, "(STUBBED) called");
+int PS4_SYSV_ABI sceHttpAddRequestHeader(int id, const char* name, const char* value,
+                                         u32 mode) {
+    LOG_DEBUG(Lib_Http, "called id = {} name = {} value = {} mode = {}", id, name ? name : "",
+              value ? value : "", mode);
+    auto req = Common::Singleton<HttpInternal>::Instance()->FindRequest(id);
+    if (!req) {
+        return ORBIS_HTTP_ERROR_INVALID_ID;
+    }
+    if (!name || !value || mode > ORBIS_HTTP_HEADER_ADD) {
+        return ORBIS_HTTP_ERROR_INVALID_VALUE;
+    }
+    if (req->state != HttpRequest::State::Idle) {
+        return ORBIS_HTTP_ERROR_AFTER_SEND;
+    }
+    if (mode == ORBIS_HTTP_HEADER_OVERWRITE) {
+        std::erase_if(req->headers, [name](const auto& h) { return h.first == name; });
+    }
+    req->headers.emplace_back(name, value);
     return ORBIS_OK;
 }
 
@@ -79,14 +194,33 @@ int PS4_SYSV_ABI sceHttpCookieImport() {
     return ORBIS_OK;
 }
 
-int PS4_SYSV_ABI sceHttpCreateConnection() {
-    LOG_ERROR(Lib_Http, "(STUBBED) called");
-    return ORBIS_OK;
+int PS4_SYSV_ABI sceHttpCreateConnection(int tmplId, const char* serverName, const char* scheme,
+                                         u16 port, int isEnableKeepalive) {
+    LOG_INFO(Lib_Http, "called tmplId = {} serverName = {} scheme = {} port = {}", tmplId,
+             serverName ? serverName : "", scheme ? scheme : "", port);
+    auto* http = Common::Singleton<HttpInternal>::Instance();
+    auto tmpl = http->FindTemplate(tmplId);
+    if (!tmpl) {
+        return ORBIS_HTTP_ERROR_INVALID_ID;
+    }
+    if (!serverName || !scheme) {
+        return ORBIS_HTTP_ERROR_INVALID_VALUE;
+    }
+    return CreateConnection(tmpl, serverName, scheme, port, isEnableKeepalive != 0);
 }
 
-int PS4_SYSV_ABI sceHttpCreateConnectionWithURL() {
-    LOG_ERROR(Lib_Http, "(STUBBED) called");
-    return ORBIS_OK;
+int PS4_SYSV_ABI sceHttpCreateConnectionWithURL(int tmplId, const char* url, bool enableKeepalive) {
+    LOG_INFO(Lib_Http, "called tmplId = {} url = {}", tmplId, url ? url : "");
+    auto* http = Common::Singleton<HttpInternal>::Instance();
+    auto tmpl = http->FindTemplate(tmplId);
+    if (!tmpl) {
+        return ORBIS_HTTP_ERROR_INVALID_ID;
+    }
+    ParsedUrl parsed;
+    if (const int result = ParseUrl(url, parsed); result < 0) {
+        return result;
+    }
+    return CreateConnection(tmpl, parsed.host, parsed.scheme, parsed.port, enableKeepalive);
 }
 
 int PS4_SYSV_ABI sceHttpCreateEpoll() {
@@ -94,29 +228,63 @@ int PS4_SYSV_ABI sceHttpCreateEpoll() {
     return ORBIS_OK;
 }
 
-int PS4_SYSV_ABI sceHttpCreateRequest() {
-    LOG_ERROR(Lib_Http, "(STUBBED) called");
-    return ORBIS_OK;
+int PS4_SYSV_ABI sceHttpCreateRequest(int connId, int method, const char* path, u64 contentLength) {
+    LOG_INFO(Lib_Http, "called connId = {} method = {} path = {}", connId, method,
+             path ? path : "");
+    if (method < ORBIS_HTTP_METHOD_GET || method > ORBIS_HTTP_METHOD_CONNECT) {
+        return ORBIS_HTTP_ERROR_UNKNOWN_METHOD;
+    }
+    return CreateRequest(connId, MethodNames[method], path, contentLength);
 }
 
-int PS4_SYSV_ABI sceHttpCreateRequest2() {
-    LOG_ERROR(Lib_Http, "(STUBBED) called");
-    return ORBIS_OK;
+int PS4_SYSV_ABI sceHttpCreateRequest2(int connId, const char* method, const char* path,
+                                       u64 contentLength) {
+    LOG_INFO(Lib_Http, "called connId = {} method = {} path = {}", connId, method ? method : "",
+             path ? path : "");
+    if (!method) {
+        return ORBIS_HTTP_ERROR_UNKNOWN_METHOD;
+    }
+    return CreateRequest(connId, method, path, contentLength);
 }
 
-int PS4_SYSV_ABI sceHttpCreateRequestWithURL() {
-    LOG_ERROR(Lib_Http, "(STUBBED) called");
-    return ORBIS_OK;
+int PS4_SYSV_ABI sceHttpCreateRequestWithURL(int connId, int method, const char* url,
+                                             u64 contentLength) {
+    LOG_INFO(Lib_Http, "called connId = {} method = {} url = {}", connId, method, url ? url : "");
+    if (method < ORBIS_HTTP_METHOD_GET || method > ORBIS_HTTP_METHOD_CONNECT) {
+        return ORBIS_HTTP_ERROR_UNKNOWN_METHOD;
+    }
+    ParsedUrl parsed;
+    if (const int result = ParseUrl(url, parsed); result < 0) {
+        return result;
+    }
+    return CreateRequest(connId, MethodNames[method], parsed.path.c_str(), contentLength);
 }
 
-int PS4_SYSV_ABI sceHttpCreateRequestWithURL2() {
-    LOG_ERROR(Lib_Http, "(STUBBED) called");
-    return ORBIS_OK;
+int PS4_SYSV_ABI sceHttpCreateRequestWithURL2(int connId, const char* method, const char* url,
+                                              u64 contentLength) {
+    LOG_INFO(Lib_Http, "called connId = {} method = {} url = {}", connId,
+             method ? method : "", url ? url : "");
+    if (!method) {
+        return ORBIS_HTTP_ERROR_UNKNOWN_METHOD;
+    }
+    ParsedUrl parsed;
+    if (const int result = ParseUrl(url, parsed); result < 0) {
+        return result;
+    }
+    return CreateRequest(connId, method, parsed.path.c_str(), contentLength);
 }
 
-int PS4_SYSV_ABI sceHttpCreateTemplate() {
-    LOG_ERROR(Lib_Http, "(STUBBED) called");
-    return ORBIS_OK;
+int PS4_SYSV_ABI sceHttpCreateTemplate(int libhttpCtxId, const char* userAgent, int httpVer,
+                                       int isAutoProxyConf) {
+    LOG_INFO(Lib_Http, "called libhttpCtxId = {} userAgent = {} httpVer = {}", libhttpCtxId,
+             userAgent ? userAgent : "", httpVer);
+    if (httpVer != ORBIS_HTTP_VERSION_1_0 && httpVer != ORBIS_HTTP_VERSION_1_1) {
+        return ORBIS_HTTP_ERROR_INVALID_VERSION;
+    }
+    auto tmpl = std::make_shared<HttpTemplate>();
+    tmpl->user_agent = userAgent ? userAgent : "";
+    tmpl->http_version = httpVer;
+    return Common::Singleton<HttpInternal>::Instance()->AddTemplate(std::move(tmpl));
 }
 
 int PS4_SYSV_ABI sceHttpDbgEnableProfile() {
@@ -159,18 +327,27 @@ int PS4_SYSV_ABI sceHttpDbgShowStat() {
     return ORBIS_OK;
 }
 
-int PS4_SYSV_ABI sceHttpDeleteConnection() {
-    LOG_ERROR(Lib_Http, "(STUBBED) called");
+int PS4_SYSV_ABI sceHttpDeleteConnection(int connId) {
+    LOG_DEBUG(Lib_Http, "called connId = {}", connId);
+    if (!Common::Singleton<HttpInternal>::Instance()->RemoveConnection(connId)) {
+        return ORBIS_HTTP_ERROR_INVALID_ID;
+    }
     return ORBIS_OK;
 }
 
-int PS4_SYSV_ABI sceHttpDeleteRequest() {
-    LOG_ERROR(Lib_Http, "(STUBBED) called");
+int PS4_SYSV_ABI sceHttpDeleteRequest(int reqId) {
+    LOG_DEBUG(Lib_Http, "called reqId = {}", reqId);
+    if (!Common::Singleton<HttpInternal>::Instance()->RemoveRequest(reqId)) {
+        return ORBIS_HTTP_ERROR_INVALID_ID;
+    }
     return ORBIS_OK;
 }
 
-int PS4_SYSV_ABI sceHttpDeleteTemplate() {
-    LOG_ERROR(Lib_Http, "(STUBBED) called");
+int PS4_SYSV_ABI sceHttpDeleteTemplate(int tmplId) {
+    LOG_DEBUG(Lib_Http, "called tmplId = {}", tmplId);
+    if (!Common::Singleton<HttpInternal>::Instance()->RemoveTemplate(tmplId)) {
+        return ORBIS_HTTP_ERROR_INVALID_ID;
+    }
     return ORBIS_OK;
 }
 
@@ -184,8 +361,20 @@ int PS4_SYSV_ABI sceHttpGetAcceptEncodingGZIPEnabled() {
     return ORBIS_OK;
 }
 
-int PS4_SYSV_ABI sceHttpGetAllResponseHeaders() {
-    LOG_ERROR(Lib_Http, "(STUBBED) called");
+int PS4_SYSV_ABI sceHttpGetAllResponseHeaders(int reqId, char** header, u64* headerSize) {
+    LOG_DEBUG(Lib_Http, "called reqId = {}", reqId);
+    auto req = Common::Singleton<HttpInternal>::Instance()->FindRequest(reqId);
+    if (!req) {
+        return ORBIS_HTTP_ERROR_INVALID_ID;
+    }
+    if (!header || !headerSize) {
+        return ORBIS_HTTP_ERROR_INVALID_VALUE;
+    }
+    if (const int result = CheckResponse(*req); result < 0) {
+        return result;
+    }
+    *header = req->response_headers.data();
+    *headerSize = req->response_headers.size();
     return ORBIS_OK;
 }
 
@@ -239,8 +428,16 @@ int PS4_SYSV_ABI sceHttpGetMemoryPoolStats() {
     return ORBIS_OK;
 }
 
-int PS4_SYSV_ABI sceHttpGetNonblock() {
-    LOG_ERROR(Lib_Http, "(STUBBED) called");
+int PS4_SYSV_ABI sceHttpGetNonblock(int id, int* isEnable) {
+    LOG_DEBUG(Lib_Http, "called id = {}", id);
+    auto settings = Common::Singleton<HttpInternal>::Instance()->FindSettings(id);
+    if (!settings) {
+        return ORBIS_HTTP_ERROR_INVALID_ID;
+    }
+    if (!isEnable) {
+        return ORBIS_HTTP_ERROR_INVALID_VALUE;
+    }
+    *isEnable = settings->nonblock ? 1 : 0;
     return ORBIS_OK;
 }
 
@@ -249,13 +446,36 @@ int PS4_SYSV_ABI sceHttpGetRegisteredCtxIds() {
     return ORBIS_OK;
 }
 
-int PS4_SYSV_ABI sceHttpGetResponseContentLength() {
-    LOG_ERROR(Lib_Http, "(STUBBED) called");
+int PS4_SYSV_ABI sceHttpGetResponseContentLength(int reqId, int* result, u64* contentLength) {
+    LOG_DEBUG(Lib_Http, "called reqId = {}", reqId);
+    auto req = Common::Singleton<HttpInternal>::Instance()->FindRequest(reqId);
+    if (!req) {
+        return ORBIS_HTTP_ERROR_INVALID_ID;
+    }
+    if (!result || !contentLength) {
+        return ORBIS_HTTP_ERROR_INVALID_VALUE;
+    }
+    if (const int ret = CheckResponse(*req); ret < 0) {
+        return ret;
+    }
+    *result = req->content_length_type;
+    *contentLength = req->response_content_length;
     return ORBIS_OK;
 }
 
-int PS4_SYSV_ABI sceHttpGetStatusCode() {
-    LOG_ERROR(Lib_Http, "(STUBBED) called");
+int PS4_SYSV_ABI sceHttpGetStatusCode(int reqId, int* statusCode) {
+    LOG_DEBUG(Lib_Http, "called reqId = {}", reqId);
+    auto req = Common::Singleton<HttpInternal>::Instance()->FindRequest(reqId);
+    if (!req) {
+        return ORBIS_HTTP_ERROR_INVALID_ID;
+    }
+    if (!statusCode) {
+        return ORBIS_HTTP_ERROR_INVALID_VALUE;
+    }
+    if (const int result = CheckResponse(*req); result < 0) {
+        return result;
+    }
+    *statusCode = req->status_code;
     return ORBIS_OK;
 }
 
@@ -277,9 +497,19 @@ int PS4_SYSV_ABI sceHttpParseStatusLine() {
     return ORBIS_OK;
 }
 
-int PS4_SYSV_ABI sceHttpReadData() {
-    LOG_ERROR(Lib_Http, "(STUBBED) called");
-    return ORBIS_OK;
+int PS4_SYSV_ABI sceHttpReadData(int reqId, void* data, u64 size) {
+    LOG_TRACE(Lib_Http, "called reqId = {} size = {}", reqId, size);
+    auto req = Common::Singleton<HttpInternal>::Instance()->FindRequest(reqId);
+    if (!req) {
+        return ORBIS_HTTP_ERROR_INVALID_ID;
+    }
+    if (!data && size > 0) {
+        return ORBIS_HTTP_ERROR_INVALID_VALUE;
+    }
+    if (req->method == "HEAD") {
+        return ORBIS_HTTP_ERROR_READ_BY_HEAD_METHOD;
+    }
+    return req->ReadBody(data, std::min<u64>(size, std::numeric_limits<s32>::max()));
 }
 
 int PS4_SYSV_ABI sceHttpRedirectCacheFlush() {
@@ -287,8 +517,16 @@ int PS4_SYSV_ABI sceHttpRedirectCacheFlush() {
     return ORBIS_OK;
 }
 
-int PS4_SYSV_ABI sceHttpRemoveRequestHeader() {
-    LOG_ERROR(Lib_Http, "(STUBBED) called");
+int PS4_SYSV_ABI sceHttpRemoveRequestHeader(int id, const char* name) {
+    LOG_DEBUG(Lib_Http, "called id = {} name = {}", id, name ? name : "");
+    auto req = Common::Singleton<HttpInternal>::Instance()->FindRequest(id);
+    if (!req) {
+        return ORBIS_HTTP_ERROR_INVALID_ID;
+    }
+    if (!name) {
+        return ORBIS_HTTP_ERROR_INVALID_VALUE;
+    }
+    std::erase_if(req->headers, [name](const auto& h) { return h.first == name; });
     return ORBIS_OK;
 }
 
@@ -317,9 +555,34 @@ int PS4_SYSV_ABI sceHttpsEnableOptionPrivate() {
     return ORBIS_OK;
 }
 
-int PS4_SYSV_ABI sceHttpSendRequest() {
-    LOG_ERROR(Lib_Http, "(STUBBED) called");
-    return ORBIS_OK;
+int PS4_SYSV_ABI sceHttpSendRequest(int reqId, const void* postData, u64 size) {
+    LOG_DEBUG(Lib_Http, "called reqId = {} size = {}", reqId, size);
+    auto* http = Common::Singleton<HttpInternal>::Instance();
+    auto req = http->FindRequest(reqId);
+    if (!req) {
+        return ORBIS_HTTP_ERROR_INVALID_ID;
+    }
+    switch (req->state.load(std::memory_order_acquire)) {
+    case HttpRequest::State::Idle:
+        break;
+    case HttpRequest::State::Sending:
+        return ORBIS_HTTP_ERROR_EAGAIN;
+    case HttpRequest::State::Error:
+        return req->error;
+    case HttpRequest::State::Receiving:
+    case HttpRequest::State::Done:
+        return ORBIS_OK;
+    }
+    if (postData && size > 0) {
+        req->post_data.assign(static_cast<const char*>(postData), size);
+    }
+    if (req->nonblock) {
+        // Keep the caller responsive, a worker performs the exchange and the title polls us.
+        req->state = HttpRequest::State::Sending;
+        http->QueueRequest(req);
+        return ORBIS_HTTP_ERROR_EAGAIN;
+    }
+    return req->Perform();
 }
 
 int PS4_SYSV_ABI sceHttpSetAcceptEncodingGZIPEnabled() {
@@ -347,8 +610,13 @@ int PS4_SYSV_ABI sceHttpSetChunkedTransferEnabled() {
     return ORBIS_OK;
 }
 
-int PS4_SYSV_ABI sceHttpSetConnectTimeOut() {
-    LOG_ERROR(Lib_Http, "(STUBBED) called");
+int PS4_SYSV_ABI sceHttpSetConnectTimeOut(int id, u32 usec) {
+    LOG_DEBUG(Lib_Http, "called id = {} usec = {}", id, usec);
+    auto settings = Common::Singleton<HttpInternal>::Instance()->FindSettings(id);
+    if (!settings) {
+        return ORBIS_HTTP_ERROR_INVALID_ID;
+    }
+    settings->connect_timeout_us = usec;
     return ORBIS_OK;
 }
 
@@ -417,8 +685,13 @@ int PS4_SYSV_ABI sceHttpSetInflateGZIPEnabled() {
     return ORBIS_OK;
 }
 
-int PS4_SYSV_ABI sceHttpSetNonblock() {
-    LOG_ERROR(Lib_Http, "(STUBBED) called");
+int PS4_SYSV_ABI sceHttpSetNonblock(int id, int isEnable) {
+    LOG_DEBUG(Lib_Http, "called id = {} isEnable = {}", id, isEnable);
+    auto settings = Common::Singleton<HttpInternal>::Instance()->FindSettings(id);
+    if (!settings) {
+        return ORBIS_HTTP_ERROR_INVALID_ID;
+    }
+    settings->nonblock = isEnable != 0;
     return ORBIS_OK;
 }
 
@@ -442,8 +715,13 @@ int PS4_SYSV_ABI sceHttpSetRecvBlockSize() {
     return ORBIS_OK;
 }
 
-int PS4_SYSV_ABI sceHttpSetRecvTimeOut() {
-    LOG_ERROR(Lib_Http, "(STUBBED) called");
+int PS4_SYSV_ABI sceHttpSetRecvTimeOut(int id, u32 usec) {
+    LOG_DEBUG(Lib_Http, "called id = {} usec = {}", id, usec);
+    auto settings = Common::Singleton<HttpInternal>::Instance()->FindSettings(id);
+    if (!settings) {
+        return ORBIS_HTTP_ERROR_INVALID_ID;
+    }
+    settings->recv_timeout_us = usec;
     return ORBIS_OK;
 }
 
@@ -452,8 +730,13 @@ int PS4_SYSV_ABI sceHttpSetRedirectCallback() {
     return ORBIS_OK;
 }
 
-int PS4_SYSV_ABI sceHttpSetRequestContentLength() {
-    LOG_ERROR(Lib_Http, "(STUBBED) called");
+int PS4_SYSV_ABI sceHttpSetRequestContentLength(int id, u64 contentLength) {
+    LOG_DEBUG(Lib_Http, "called id = {} contentLength = {}", id, contentLength);
+    auto req = Common::Singleton<HttpInternal>::Instance()->FindRequest(id);
+    if (!req) {
+        return ORBIS_HTTP_ERROR_INVALID_ID;
+    }
+    req->content_length = contentLength;
     return ORBIS_OK;
 }
 
@@ -477,8 +760,13 @@ int PS4_SYSV_ABI sceHttpSetResponseHeaderMaxSize() {
     return ORBIS_OK;
 }
 
-int PS4_SYSV_ABI sceHttpSetSendTimeOut() {
-    LOG_ERROR(Lib_Http, "(STUBBED) called");
+int PS4_SYSV_ABI sceHttpSetSendTimeOut(int id, u32 usec) {
+    LOG_DEBUG(Lib_Http, "called id = {} usec = {}", id, usec);
+    auto settings = Common::Singleton<HttpInternal>::Instance()->FindSettings(id);
+    if (!settings) {
+        return ORBIS_HTTP_ERROR_INVALID_ID;
+    }
+    settings->send_timeout_us = usec;
     return ORBIS_OK;
 }
 
@@ -24,12 +24,13 @@ struct OrbisHttpUriElement {
     u8 reserved[10];
 };
 
-int PS4_SYSV_ABI sceHttpAbortRequest();
+int PS4_SYSV_ABI sceHttpAbortRequest(int reqId);
 int PS4_SYSV_ABI sceHttpAbortRequestForce();
 int PS4_SYSV_ABI sceHttpAbortWaitRequest();
 int PS4_SYSV_ABI sceHttpAddCookie();
 int PS4_SYSV_ABI sceHttpAddQuery();
-int PS4_SYSV_ABI sceHttpAddRequestHeader();
+int PS4_SYSV_ABI sceHttpAddRequestHeader(int id, const char* name, const char* value,
+                                         u32 mode);
 int PS4_SYSV_ABI sceHttpAddRequestHeaderRaw();
 int PS4_SYSV_ABI sceHttpAuthCacheExport();
 int PS4_SYSV_ABI sceHttpAuthCacheFlush();
@@ -38,14 +39,19 @@ int PS4_SYSV_ABI sceHttpCacheRedirectedConnectionEnabled();
 int PS4_SYSV_ABI sceHttpCookieExport();
 int PS4_SYSV_ABI sceHttpCookieFlush();
 int PS4_SYSV_ABI sceHttpCookieImport();
-int PS4_SYSV_ABI sceHttpCreateConnection();
-int PS4_SYSV_ABI sceHttpCreateConnectionWithURL();
+int PS4_SYSV_ABI sceHttpCreateConnection(int tmplId, const char* serverName, const char* scheme,
+                                         u16 port, int isEnableKeepalive);
+int PS4_SYSV_ABI sceHttpCreateConnectionWithURL(int tmplId, const char* url, bool enableKeepalive);
 int PS4_SYSV_ABI sceHttpCreateEpoll();
-int PS4_SYSV_ABI sceHttpCreateRequest();
-int PS4_SYSV_ABI sceHttpCreateRequest2();
-int PS4_SYSV_ABI sceHttpCreateRequestWithURL();
-int PS4_SYSV_ABI sceHttpCreateRequestWithURL2();
-int PS4_SYSV_ABI sceHttpCreateTemplate();
+int PS4_SYSV_ABI sceHttpCreateRequest(int connId, int method, const char* path, u64 contentLength);
+int PS4_SYSV_ABI sceHttpCreateRequest2(int connId, const char* method, const char* path,
+                                       u64 contentLength);
+int PS4_SYSV_ABI sceHttpCreateRequestWithURL(int connId, int method, const char* url,
+                                             u64 contentLength);
+int PS4_SYSV_ABI sceHttpCreateRequestWithURL2(int connId, const char* method, const char* url,
+                                              u64 contentLength);
+int PS4_SYSV_ABI sceHttpCreateTemplate(int libhttpCtxId, const char* userAgent, int httpVer,
+                                       int isAutoProxyConf);
 int PS4_SYSV_ABI sceHttpDbgEnableProfile();
 int PS4_SYSV_ABI sceHttpDbgGetConnectionStat();
 int PS4_SYSV_ABI sceHttpDbgGetRequestStat();
@@ -54,12 +60,12 @@ int PS4_SYSV_ABI sceHttpDbgShowConnectionStat();
 int PS4_SYSV_ABI sceHttpDbgShowMemoryPoolStat();
 int PS4_SYSV_ABI sceHttpDbgShowRequestStat();
 int PS4_SYSV_ABI sceHttpDbgShowStat();
-int PS4_SYSV_ABI sceHttpDeleteConnection();
-int PS4_SYSV_ABI sceHttpDeleteRequest();
-int PS4_SYSV_ABI sceHttpDeleteTemplate();
+int PS4_SYSV_ABI sceHttpDeleteConnection(int connId);
+int PS4_SYSV_ABI sceHttpDeleteRequest(int reqId);
+int PS4_SYSV_ABI sceHttpDeleteTemplate(int tmplId);
 int PS4_SYSV_ABI sceHttpDestroyEpoll();
 int PS4_SYSV_ABI sceHttpGetAcceptEncodingGZIPEnabled();
-int PS4_SYSV_ABI sceHttpGetAllResponseHeaders();
+int PS4_SYSV_ABI sceHttpGetAllResponseHeaders(int reqId, char** header, u64* headerSize);
 int PS4_SYSV_ABI sceHttpGetAuthEnabled();
 int PS4_SYSV_ABI sceHttpGetAutoRedirect();
 int PS4_SYSV_ABI sceHttpGetConnectionStat();
@@ -70,28 +76,28 @@ int PS4_SYSV_ABI sceHttpGetEpoll();
 int PS4_SYSV_ABI sceHttpGetEpollId();
 int PS4_SYSV_ABI sceHttpGetLastErrno();
 int PS4_SYSV_ABI sceHttpGetMemoryPoolStats();
-int PS4_SYSV_ABI sceHttpGetNonblock();
+int PS4_SYSV_ABI sceHttpGetNonblock(int id, int* isEnable);
 int PS4_SYSV_ABI sceHttpGetRegisteredCtxIds();
-int PS4_SYSV_ABI sceHttpGetResponseContentLength();
-int PS4_SYSV_ABI sceHttpGetStatusCode();
+int PS4_SYSV_ABI sceHttpGetResponseContentLength(int reqId, int* result, u64* contentLength);
+int PS4_SYSV_ABI sceHttpGetStatusCode(int reqId, int* statusCode);
 int PS4_SYSV_ABI sceHttpInit(int libnetMemId, int libsslCtxId, std::size_t poolSize);
 int PS4_SYSV_ABI sceHttpParseResponseHeader();
 int PS4_SYSV_ABI sceHttpParseStatusLine();
-int PS4_SYSV_ABI sceHttpReadData();
+int PS4_SYSV_ABI sceHttpReadData(int reqId, void* data, u64 size);
 int PS4_SYSV_ABI sceHttpRedirectCacheFlush();
-int PS4_SYSV_ABI sceHttpRemoveRequestHeader();
+int PS4_SYSV_ABI sceHttpRemoveRequestHeader(int id, const char* name);
 int PS4_SYSV_ABI sceHttpRequestGetAllHeaders();
 int PS4_SYSV_ABI sceHttpsDisableOption();
 int PS4_SYSV_ABI sceHttpsDisableOptionPrivate();
 int PS4_SYSV_ABI sceHttpsEnableOption();
 int PS4_SYSV_ABI sceHttpsEnableOptionPrivate();
-int PS4_SYSV_ABI sceHttpSendRequest();
+int PS4_SYSV_ABI sceHttpSendRequest(int reqId, const void* postData, u64 size);
 int PS4_SYSV_ABI sceHttpSetAcceptEncodingGZIPEnabled();
 int PS4_SYSV_ABI sceHttpSetAuthEnabled();
 int PS4_SYSV_ABI sceHttpSetAuthInfoCallback();
 int PS4_SYSV_ABI sceHttpSetAutoRedirect();
 int PS4_SYSV_ABI sceHttpSetChunkedTransferEnabled();
-int PS4_SYSV_ABI sceHttpSetConnectTimeOut();
+int PS4_SYSV_ABI sceHttpSetConnectTimeOut(int id, u32 usec);
 int PS4_SYSV_ABI sceHttpSetCookieEnabled();
 int PS4_SYSV_ABI sceHttpSetCookieMaxNum();
 int PS4_SYSV_ABI sceHttpSetCookieMaxNumPerDomain();
@@ -105,19 +111,19 @@ int PS4_SYSV_ABI sceHttpSetEpoll();
 int PS4_SYSV_ABI sceHttpSetEpollId();
 int PS4_SYSV_ABI sceHttpSetHttp09Enabled();
 int PS4_SYSV_ABI sceHttpSetInflateGZIPEnabled();
-int PS4_SYSV_ABI sceHttpSetNonblock();
+int PS4_SYSV_ABI sceHttpSetNonblock(int id, int isEnable);
 int PS4_SYSV_ABI sceHttpSetPolicyOption();
 int PS4_SYSV_ABI sceHttpSetPriorityOption();
 int PS4_SYSV_ABI sceHttpSetProxy();
 int PS4_SYSV_ABI sceHttpSetRecvBlockSize();
-int PS4_SYSV_ABI sceHttpSetRecvTimeOut();
+int PS4_SYSV_ABI sceHttpSetRecvTimeOut(int id, u32 usec);
 int PS4_SYSV_ABI sceHttpSetRedirectCallback();
-int PS4_SYSV_ABI sceHttpSetRequestContentLength();
+int PS4_SYSV_ABI sceHttpSetRequestContentLength(int id, u64 contentLength);
 int PS4_SYSV_ABI sceHttpSetRequestStatusCallback();
 int PS4_SYSV_ABI sceHttpSetResolveRetry();
 int PS4_SYSV_ABI sceHttpSetResolveTimeOut();
 int PS4_SYSV_ABI sceHttpSetResponseHeaderMaxSize();
-int PS4_SYSV_ABI sceHttpSetSendTimeOut();
+int PS4_SYSV_ABI sceHttpSetSendTimeOut(int id, u32 usec);
 int PS4_SYSV_ABI sceHttpSetSocketCreationCallback();
 int PS4_SYSV_ABI sceHttpsFreeCaList();
 int PS4_SYSV_ABI sceHttpsGetCaList();
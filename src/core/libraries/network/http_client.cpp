@@ -0,0 +1,728 @@
+// SPDX-FileCopyrightText: Copyright 2025 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <charconv>
+#include <climits>
+#include <cstring>
+#include <functional>
+#include <optional>
+#include <fmt/format.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <poll.h>
+#endif
+
+#include "common/logging/log.h"
+#include "common/polyfill_thread.h"
+#include "common/thread.h"
+#include "core/libraries/error_codes.h"
+#include "http_client.h"
+#include "http_error.h"
+
+namespace Libraries::Http {
+
+namespace {
+
+/// Responses with a larger header than this are rejected.
+constexpr size_t MaxResponseHeaderSize = 64_KB;
+
+/// Amount of data requested from the host socket per receive.
+constexpr size_t RecvBlockSize = 16_KB;
+
+/// Number of workers performing non-blocking requests.
+constexpr size_t NumIoThreads = 4;
+
+#ifdef _WIN32
+constexpr net_socket InvalidSocket = INVALID_SOCKET;
+#else
+constexpr net_socket InvalidSocket = -1;
+#endif
+
+int PollSocket(net_socket sock, short events, int timeout_ms) {
+#ifdef _WIN32
+    WSAPOLLFD fd{.fd = sock, .events = events, .revents = 0};
+    return WSAPoll(&fd, 1, timeout_ms);
+#else
+    pollfd fd{.fd = sock, .events = events, .revents = 0};
+    int ret;
+    do {
+        ret = poll(&fd, 1, timeout_ms);
+    } while (ret < 0 && errno == EINTR);
+    return ret;
+#endif
+}
+
+int ToPollTimeout(u32 timeout_us) {
+    return static_cast<int>(std::min<u64>((u64{timeout_us} + 999) / 1000, INT_MAX));
+}
+
+void CloseSocket(net_socket sock) {
+#ifdef _WIN32
+    closesocket(sock);
+#else
+    close(sock);
+#endif
+}
+
+void SetBlocking(net_socket sock, bool blocking) {
+#ifdef _WIN32
+    u_long mode = blocking ? 0 : 1;
+    ioctlsocket(sock, FIONBIO, &mode);
+#else
+    const int flags = fcntl(sock, F_GETFL, 0);
+    fcntl(sock, F_SETFL, blocking ? (flags & ~O_NONBLOCK) : (flags | O_NONBLOCK));
+#endif
+}
+
+bool IsConnectInProgress() {
+#ifdef _WIN32
+    return WSAGetLastError() == WSAEWOULDBLOCK;
+#else
+    return errno == EINPROGRESS;
+#endif
+}
+
+bool EqualsIgnoreCase(std::string_view a, std::string_view b) {
+    return std::ranges::equal(a, b, [](char l, char r) { return tolower(l) == tolower(r); });
+}
+
+bool ContainsIgnoreCase(std::string_view haystack, std::string_view needle) {
+    const auto it = std::ranges::search(haystack, needle, [](char l, char r) {
+        return tolower(l) == tolower(r);
+    });
+    return !it.empty();
+}
+
+std::string_view Trim(std::string_view str) {
+    while (!str.empty() && (str.front() == ' ' || str.front() == '\t')) {
+        str.remove_prefix(1);
+    }
+    while (!str.empty() && (str.back() == ' ' || str.back() == '\t')) {
+        str.remove_suffix(1);
+    }
+    return str;
+}
+
+} // Anonymous namespace
+
+HttpSocket::HttpSocket(net_socket sock_) : sock{sock_} {}
+
+HttpSocket::~HttpSocket() {
+    CloseSocket(sock);
+}
+
+std::unique_ptr<HttpSocket> HttpSocket::Connect(const std::string& host, u16 port, u32 timeout_us,
+                                                int& error) {
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_protocol = IPPROTO_TCP;
+    addrinfo* result = nullptr;
+    if (getaddrinfo(host.c_str(), std::to_string(port).c_str(), &hints, &result) != 0) {
+        LOG_WARNING(Lib_Http, "Failed to resolve {}", host);
+        error = ORBIS_HTTP_ERROR_RESOLVER_ENOHOST;
+        return nullptr;
+    }
+
+    error = ORBIS_HTTP_ERROR_NETWORK;
+    for (const addrinfo* ai = result; ai; ai = ai->ai_next) {
+        const net_socket sock = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+        if (sock == InvalidSocket) {
+            continue;
+        }
+        // Connect without blocking so the configured timeout can be honored.
+        SetBlocking(sock, false);
+        const int ret = connect(sock, ai->ai_addr, static_cast<socklen_t>(ai->ai_addrlen));
+        if (ret != 0 && !IsConnectInProgress()) {
+            CloseSocket(sock);
+            continue;
+        }
+        if (ret != 0) {
+            const int ready = PollSocket(sock, POLLOUT, ToPollTimeout(timeout_us));
+            int so_error = 0;
+            socklen_t len = sizeof(so_error);
+            if (ready <= 0 ||
+                getsockopt(sock, SOL_SOCKET, SO_ERROR, reinterpret_cast<char*>(&so_error),
+                           &len) != 0 ||
+                so_error != 0) {
+                error = ready == 0 ? ORBIS_HTTP_ERROR_TIMEOUT : ORBIS_HTTP_ERROR_NETWORK;
+                CloseSocket(sock);
+                continue;
+            }
+        }
+        SetBlocking(sock, true);
+        const int nodelay = 1;
+        setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&nodelay),
+                   sizeof(nodelay));
+        freeaddrinfo(result);
+        return std::make_unique<HttpSocket>(sock);
+    }
+    freeaddrinfo(result);
+    LOG_WARNING(Lib_Http, "Failed to connect to {}:{}", host, port);
+    return nullptr;
+}
+
+int HttpSocket::Send(std::string_view data, u32 timeout_us) {
+#ifdef __linux__
+    constexpr int flags = MSG_NOSIGNAL;
+#else
+    constexpr int flags = 0;
+#endif
+    while (!data.empty()) {
+        const int ready = PollSocket(sock, POLLOUT, ToPollTimeout(timeout_us));
+        if (ready == 0) {
+            return ORBIS_HTTP_ERROR_TIMEOUT;
+        }
+        const int chunk = static_cast<int>(std::min<size_t>(data.size(), INT_MAX));
+        const auto sent = send(sock, data.data(), chunk, flags);
+        if (ready < 0 || sent <= 0) {
+            return ORBIS_HTTP_ERROR_NETWORK;
+        }
+        data.remove_prefix(static_cast<size_t>(sent));
+    }
+    return ORBIS_OK;
+}
+
+int HttpSocket::Fill(bool block, u32 timeout_us) {
+    if (read_pos > 0 && read_pos == buffer.size()) {
+        buffer.clear();
+        read_pos = 0;
+    } else if (read_pos >= RecvBlockSize) {
+        buffer.erase(0, read_pos);
+        read_pos = 0;
+    }
+
+    const int ready = PollSocket(sock, POLLIN, block ? ToPollTimeout(timeout_us) : 0);
+    if (ready == 0) {
+        return block ? ORBIS_HTTP_ERROR_TIMEOUT : ORBIS_HTTP_ERROR_EAGAIN;
+    }
+    if (ready < 0) {
+        return ORBIS_HTTP_ERROR_NETWORK;
+    }
+
+    const size_t old_size = buffer.size();
+    buffer.resize(old_size + RecvBlockSize);
+    const auto received =
+        recv(sock, buffer.data() + old_size, static_cast<int>(RecvBlockSize), 0);
+    buffer.resize(old_size + std::max<decltype(received)>(received, 0));
+    if (received < 0) {
+        return ORBIS_HTTP_ERROR_NETWORK;
+    }
+    return static_cast<int>(received);
+}
+
+void HttpSocket::Consume(size_t size) {
+    read_pos += size;
+    if (read_pos == buffer.size()) {
+        buffer.clear();
+        read_pos = 0;
+    }
+}
+
+void HttpSocket::Shutdown() {
+#ifdef _WIN32
+    shutdown(sock, SD_BOTH);
+#else
+    shutdown(sock, SHUT_RDWR);
+#endif
+}
+
+std::unique_ptr<HttpSocket> HttpTemplate::AcquireSocket(const std::string& key) {
+    std::scoped_lock lock{pool_mutex};
+    const auto it = idle_sockets.find(key);
+    if (it == idle_sockets.end()) {
+        return nullptr;
+    }
+    auto& sockets = it->second;
+    while (!sockets.empty()) {
+        auto socket = std::move(sockets.back());
+        sockets.pop_back();
+        // An idle connection that became readable was closed by the server or is out of sync.
+        if (socket->Fill(false, 0) == ORBIS_HTTP_ERROR_EAGAIN) {
+            return socket;
+        }
+    }
+    return nullptr;
+}
+
+void HttpTemplate::ReleaseSocket(const std::string& key, std::unique_ptr<HttpSocket> socket) {
+    std::scoped_lock lock{pool_mutex};
+    auto& sockets = idle_sockets[key];
+    if (sockets.size() < MaxIdleSocketsPerHost) {
+        sockets.push_back(std::move(socket));
+    }
+}
+
+int HttpRequest::Perform() {
+    state.store(State::Sending, std::memory_order_release);
+    bool reused = false;
+    int result = SendAndReceiveHeader(true, reused);
+    if (result < 0 && reused && !aborted) {
+        // The pooled connection went stale between requests, retry once on a fresh one.
+        {
+            std::scoped_lock lock{socket_mutex};
+            socket.reset();
+        }
+        result = SendAndReceiveHeader(false, reused);
+    }
+    if (result < 0) {
+        return Fail(aborted ? ORBIS_HTTP_ERROR_ABORTED : result);
+    }
+    // Decide on an empty body before publishing the state, a reader on another thread must never
+    // see Receiving for a body that is already complete.
+    if (body_mode == BodyMode::None || (body_mode == BodyMode::Length && body_remaining == 0)) {
+        FinishBody();
+    } else {
+        state.store(State::Receiving, std::memory_order_release);
+    }
+    return ORBIS_OK;
+}
+
+int HttpRequest::SendAndReceiveHeader(bool allow_reuse, bool& reused) {
+    const auto& conn = *connection;
+    if (!EqualsIgnoreCase(conn.scheme, "http")) {
+        LOG_ERROR(Lib_Http, "Unsupported scheme {}", conn.scheme);
+        return EqualsIgnoreCase(conn.scheme, "https") ? ORBIS_HTTP_ERROR_SSL
+                                                      : ORBIS_HTTP_ERROR_UNKNOWN_SCHEME;
+    }
+
+    const std::string key = conn.PoolKey();
+    auto new_socket = allow_reuse && conn.keep_alive ? conn.tmpl->AcquireSocket(key) : nullptr;
+    reused = new_socket != nullptr;
+    if (!new_socket) {
+        int error;
+        new_socket = HttpSocket::Connect(conn.host, conn.port, connect_timeout_us, error);
+        if (!new_socket) {
+            return error;
+        }
+    }
+    {
+        std::scoped_lock lock{socket_mutex};
+        if (aborted) {
+            return ORBIS_HTTP_ERROR_ABORTED;
+        }
+        socket = std::move(new_socket);
+    }
+
+    const auto has_header = [this](std::string_view name) {
+        return std::ranges::any_of(
+            headers, [name](const auto& h) { return EqualsIgnoreCase(h.first, name); });
+    };
+    const bool http10 = conn.tmpl->http_version == ORBIS_HTTP_VERSION_1_0;
+    std::string request = fmt::format("{} {} HTTP/1.{}\r\n", method, path.empty() ? "/" : path,
+                                      http10 ? 0 : 1);
+    if (!has_header("Host")) {
+        request += conn.port == 80 ? fmt::format("Host: {}\r\n", conn.host)
+                                   : fmt::format("Host: {}:{}\r\n", conn.host, conn.port);
+    }
+    if (!has_header("User-Agent") && !conn.tmpl->user_agent.empty()) {
+        request += fmt::format("User-Agent: {}\r\n", conn.tmpl->user_agent);
+    }
+    if (!has_header("Connection")) {
+        request += conn.keep_alive ? "Connection: keep-alive\r\n" : "Connection: close\r\n";
+    }
+    // Only announce the bytes that are actually sent, the server would otherwise wait for a body
+    // that never arrives.
+    const u64 body_size = post_data.size();
+    if (content_length != 0 && content_length != body_size) {
+        LOG_WARNING(Lib_Http, "Declared content length {} but sending {} bytes", content_length,
+                    body_size);
+    }
+    if (!has_header("Content-Length") &&
+        (body_size > 0 || method == "POST" || method == "PUT")) {
+        request += fmt::format("Content-Length: {}\r\n", body_size);
+    }
+    for (const auto& [name, value] : headers) {
+        request += fmt::format("{}: {}\r\n", name, value);
+    }
+    request += "\r\n";
+    request += post_data;
+
+    const int result = socket->Send(request, send_timeout_us);
+    if (result < 0) {
+        return result;
+    }
+
+    while (true) {
+        const auto buffered = socket->Buffered();
+        const size_t end = buffered.find("\r\n\r\n");
+        if (end != std::string_view::npos) {
+            const int parsed = ParseHeader(buffered.substr(0, end + 4));
+            socket->Consume(end + 4);
+            if (parsed < 0) {
+                return parsed;
+            }
+            // Skip interim responses such as 100 Continue.
+            if (status_code / 100 != 1) {
+                return ORBIS_OK;
+            }
+            continue;
+        }
+        if (buffered.size() > MaxResponseHeaderSize) {
+            return ORBIS_HTTP_ERROR_TOO_LARGE_RESPONSE_HEADER;
+        }
+        const int received = socket->Fill(true, recv_timeout_us);
+        if (received == 0) {
+            return ORBIS_HTTP_ERROR_NETWORK;
+        }
+        if (received < 0) {
+            return received;
+        }
+    }
+}
+
+int HttpRequest::ParseHeader(std::string_view header) {
+    if (!header.starts_with("HTTP/1.")) {
+        return ORBIS_HTTP_ERROR_BAD_RESPONSE;
+    }
+    const size_t code_start = header.find(' ');
+    if (code_start == std::string_view::npos) {
+        return ORBIS_HTTP_ERROR_BAD_RESPONSE;
+    }
+    const char* code_begin = header.data() + code_start + 1;
+    const auto [ptr, ec] = std::from_chars(code_begin, header.data() + header.size(), status_code);
+    if (ec != std::errc{}) {
+        return ORBIS_HTTP_ERROR_BAD_RESPONSE;
+    }
+    response_headers = header;
+
+    const bool http10 = header.starts_with("HTTP/1.0");
+    bool keep_alive = !http10;
+    bool chunked = false;
+    std::optional<u64> length;
+
+    size_t pos = header.find("\r\n") + 2;
+    while (pos < header.size()) {
+        const size_t line_end = header.find("\r\n", pos);
+        const auto line = header.substr(pos, line_end - pos);
+        pos = line_end + 2;
+        const size_t colon = line.find(':');
+        if (colon == std::string_view::npos) {
+            continue;
+        }
+        const auto name = Trim(line.substr(0, colon));
+        const auto value = Trim(line.substr(colon + 1));
+        if (EqualsIgnoreCase(name, "Content-Length")) {
+            u64 parsed;
+            if (std::from_chars(value.data(), value.data() + value.size(), parsed).ec ==
+                std::errc{}) {
+                length = parsed;
+            }
+        } else if (EqualsIgnoreCase(name, "Transfer-Encoding")) {
+            chunked = ContainsIgnoreCase(value, "chunked");
+        } else if (EqualsIgnoreCase(name, "Connection")) {
+            if (ContainsIgnoreCase(value, "close")) {
+                keep_alive = false;
+            } else if (ContainsIgnoreCase(value, "keep-alive")) {
+                keep_alive = true;
+            }
+        }
+    }
+
+    response_keep_alive = keep_alive && connection->keep_alive;
+    response_content_length = length.value_or(0);
+    content_length_type = length ? ORBIS_HTTP_CONTENTLEN_EXIST : ORBIS_HTTP_CONTENTLEN_NOT_FOUND;
+    chunk_needs_crlf = false;
+    chunk_in_trailer = false;
+    if (method == "HEAD" || status_code / 100 == 1 || status_code == 204 || status_code == 304) {
+        body_mode = BodyMode::None;
+    } else if (chunked) {
+        body_mode = BodyMode::Chunked;
+        body_remaining = 0;
+        content_length_type = ORBIS_HTTP_CONTENTLEN_CHUNK_ENC;
+    } else if (length) {
+        body_mode = BodyMode::Length;
+        body_remaining = *length;
+    } else {
+        body_mode = BodyMode::UntilClose;
+        response_keep_alive = false;
+    }
+    return ORBIS_OK;
+}
+
+int HttpRequest::FillSocket(HttpSocket& sock, bool block) {
+    const int result = sock.Fill(block, recv_timeout_us);
+    return aborted ? ORBIS_HTTP_ERROR_ABORTED : result;
+}
+
+int HttpRequest::ReadChunkHeader(HttpSocket& sock, bool block) {
+    while (true) {
+        const auto buffered = sock.Buffered();
+        if (chunk_needs_crlf && buffered.size() >= 2) {
+            if (!buffered.starts_with("\r\n")) {
+                return ORBIS_HTTP_ERROR_CHUNK_ENC;
+            }
+            sock.Consume(2);
+            chunk_needs_crlf = false;
+            continue;
+        }
+        const size_t line_end = chunk_needs_crlf ? std::string_view::npos : buffered.find("\r\n");
+        if (line_end != std::string_view::npos) {
+            const auto line = buffered.substr(0, line_end);
+            sock.Consume(line_end + 2);
+            if (chunk_in_trailer) {
+                // Trailer fields are ignored, an empty line terminates the body.
+                if (line.empty()) {
+                    return 0;
+                }
+                continue;
+            }
+            u64 size;
+            if (std::from_chars(line.data(), line.data() + line.size(), size, 16).ec !=
+                std::errc{}) {
+                return ORBIS_HTTP_ERROR_CHUNK_ENC;
+            }
+            if (size == 0) {
+                chunk_in_trailer = true;
+                continue;
+            }
+            body_remaining = size;
+            return 1;
+        }
+        const int received = FillSocket(sock, block);
+        if (received == 0) {
+            return ORBIS_HTTP_ERROR_BROKEN;
+        }
+        if (received < 0) {
+            return received;
+        }
+    }
+}
+
+int HttpRequest::ReadBody(void* data, size_t size) {
+    // Readers own the socket while the body is received, FinishBody and Fail below release it.
+    std::scoped_lock read_lock{read_mutex};
+    switch (state.load(std::memory_order_acquire)) {
+    case State::Idle:
+        return ORBIS_HTTP_ERROR_BEFORE_SEND;
+    case State::Sending:
+        return ORBIS_HTTP_ERROR_EAGAIN;
+    case State::Error:
+        return error;
+    case State::Done:
+        return 0;
+    case State::Receiving:
+        break;
+    }
+    if (aborted) {
+        return Fail(ORBIS_HTTP_ERROR_ABORTED);
+    }
+    if (body_mode == BodyMode::None || (body_mode == BodyMode::Length && body_remaining == 0)) {
+        FinishBody();
+        return 0;
+    }
+    HttpSocket* sock;
+    {
+        std::scoped_lock lock{socket_mutex};
+        sock = socket.get();
+    }
+    if (!sock) {
+        return Fail(ORBIS_HTTP_ERROR_BROKEN);
+    }
+
+    // Hand out whatever is available instead of waiting to fill the whole buffer.
+    u8* out = static_cast<u8*>(data);
+    size_t total = 0;
+    while (total < size) {
+        const bool block = !nonblock && total == 0;
+        if (body_mode == BodyMode::Chunked && body_remaining == 0) {
+            const int result = ReadChunkHeader(*sock, block);
+            if (result == 0) {
+                FinishBody();
+                break;
+            }
+            if (result == ORBIS_HTTP_ERROR_EAGAIN && total > 0) {
+                break;
+            }
+            if (result < 0) {
+                return result == ORBIS_HTTP_ERROR_EAGAIN ? result : Fail(result);
+            }
+        }
+
+        const auto buffered = sock->Buffered();
+        if (buffered.empty()) {
+            if (total > 0) {
+                break;
+            }
+            const int received = FillSocket(*sock, block);
+            if (received == 0) {
+                if (body_mode == BodyMode::UntilClose) {
+                    FinishBody();
+                    break;
+                }
+                return Fail(ORBIS_HTTP_ERROR_BROKEN);
+            }
+            if (received < 0) {
+                return received == ORBIS_HTTP_ERROR_EAGAIN ? received : Fail(received);
+            }
+            continue;
+        }
+
+        size_t count = std::min(size - total, buffered.size());
+        if (body_mode != BodyMode::UntilClose) {
+            count = static_cast<size_t>(std::min<u64>(count, body_remaining));
+        }
+        std::memcpy(out + total, buffered.data(), count);
+        sock->Consume(count);
+        total += count;
+        if (body_mode == BodyMode::UntilClose) {
+            continue;
+        }
+        body_remaining -= count;
+        if (body_mode == BodyMode::Length && body_remaining == 0) {
+            FinishBody();
+            break;
+        }
+        if (body_mode == BodyMode::Chunked && body_remaining == 0) {
+            chunk_needs_crlf = true;
+        }
+    }
+    return static_cast<int>(total);
+}
+
+int HttpRequest::Fail(int result) {
+    {
+        std::scoped_lock lock{socket_mutex};
+        socket.reset();
+    }
+    error = result;
+    state.store(State::Error, std::memory_order_release);
+    return result;
+}
+
+void HttpRequest::FinishBody() {
+    std::unique_ptr<HttpSocket> finished;
+    {
+        std::scoped_lock lock{socket_mutex};
+        finished = std::move(socket);
+    }
+    if (finished && response_keep_alive && !aborted && finished->Buffered().empty()) {
+        connection->tmpl->ReleaseSocket(connection->PoolKey(), std::move(finished));
+    }
+    state.store(State::Done, std::memory_order_release);
+}
+
+void HttpRequest::Abort() {
+    aborted = true;
+    std::scoped_lock lock{socket_mutex};
+    if (socket) {
+        socket->Shutdown();
+    }
+}
+
+HttpInternal::HttpInternal() {
+    for (size_t i = 0; i < NumIoThreads; i++) {
+        io_threads.emplace_back(std::bind_front(&HttpInternal::IoThread, this));
+    }
+}
+
+HttpInternal::~HttpInternal() = default;
+
+int HttpInternal::AddTemplate(HttpTemplatePtr tmpl) {
+    std::scoped_lock lock{m_mutex};
+    const int id = ++next_id;
+    templates.emplace(id, std::move(tmpl));
+    return id;
+}
+
+int HttpInternal::AddConnection(HttpConnectionPtr conn) {
+    std::scoped_lock lock{m_mutex};
+    const int id = ++next_id;
+    connections.emplace(id, std::move(conn));
+    return id;
+}
+
+int HttpInternal::AddRequest(HttpRequestPtr req) {
+    std::scoped_lock lock{m_mutex};
+    const int id = ++next_id;
+    requests.emplace(id, std::move(req));
+    return id;
+}
+
+HttpTemplatePtr HttpInternal::FindTemplate(int id) {
+    std::scoped_lock lock{m_mutex};
+    const auto it = templates.find(id);
+    return it != templates.end() ? it->second : nullptr;
+}
+
+HttpConnectionPtr HttpInternal::FindConnection(int id) {
+    std::scoped_lock lock{m_mutex};
+    const auto it = connections.find(id);
+    return it != connections.end() ? it->second : nullptr;
+}
+
+HttpRequestPtr HttpInternal::FindRequest(int id) {
+    std::scoped_lock lock{m_mutex};
+    const auto it = requests.find(id);
+    return it != requests.end() ? it->second : nullptr;
+}
+
+std::shared_ptr<HttpSettings> HttpInternal::FindSettings(int id) {
+    std::scoped_lock lock{m_mutex};
+    if (const auto it = requests.find(id); it != requests.end()) {
+        return it->second;
+    }
+    if (const auto it = connections.find(id); it != connections.end()) {
+        return it->second;
+    }
+    if (const auto it = templates.find(id); it != templates.end()) {
+        return it->second;
+    }
+    return nullptr;
+}
+
+bool HttpInternal::RemoveTemplate(int id) {
+    std::scoped_lock lock{m_mutex};
+    return templates.erase(id) != 0;
+}
+
+bool HttpInternal::RemoveConnection(int id) {
+    std::scoped_lock lock{m_mutex};
+    return connections.erase(id) != 0;
+}
+
+bool HttpInternal::RemoveRequest(int id) {
+    HttpRequestPtr req;
+    {
+        std::scoped_lock lock{m_mutex};
+        const auto it = requests.find(id);
+        if (it == requests.end()) {
+            return false;
+        }
+        req = std::move(it->second);
+        requests.erase(it);
+    }
+    // A worker may still hold the request, make sure it stops promptly.
+    req->Abort();
+    return true;
+}
+
+void HttpInternal::QueueRequest(HttpRequestPtr req) {
+    {
+        std::scoped_lock lk{io_mutex};
+        io_queue.push(std::move(req));
+    }
+    io_cv.notify_one();
+}
+
+void HttpInternal::IoThread(std::stop_token stoken) {
+    Common::SetCurrentThreadName("shadPS4:HttpIo");
+
+    while (!stoken.stop_requested()) {
+        HttpRequestPtr req;
+        {
+            std::unique_lock lk{io_mutex};
+            Common::CondvarWait(io_cv, lk, stoken, [this] { return !io_queue.empty(); });
+            if (stoken.stop_requested()) {
+                break;
+            }
+            req = std::move(io_queue.front());
+            io_queue.pop();
+        }
+        req->Perform();
+    }
+}
+
+} // namespace Libraries::Http
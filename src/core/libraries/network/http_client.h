@@ -0,0 +1,220 @@
+// SPDX-FileCopyrightText: Copyright 2025 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "common/types.h"
+#include "core/libraries/network/sockets.h"
+
+namespace Libraries::Http {
+
+enum OrbisHttpMethod : s32 {
+    ORBIS_HTTP_METHOD_GET = 0,
+    ORBIS_HTTP_METHOD_POST = 1,
+    ORBIS_HTTP_METHOD_HEAD = 2,
+    ORBIS_HTTP_METHOD_OPTIONS = 3,
+    ORBIS_HTTP_METHOD_PUT = 4,
+    ORBIS_HTTP_METHOD_DELETE = 5,
+    ORBIS_HTTP_METHOD_TRACE = 6,
+    ORBIS_HTTP_METHOD_CONNECT = 7,
+};
+
+enum OrbisHttpVersion : s32 {
+    ORBIS_HTTP_VERSION_1_0 = 1,
+    ORBIS_HTTP_VERSION_1_1 = 2,
+};
+
+enum OrbisHttpContentLengthType : s32 {
+    ORBIS_HTTP_CONTENTLEN_EXIST = 0,
+    ORBIS_HTTP_CONTENTLEN_NOT_FOUND = 1,
+    ORBIS_HTTP_CONTENTLEN_CHUNK_ENC = 2,
+};
+
+enum OrbisHttpHeaderMode : u32 {
+    ORBIS_HTTP_HEADER_OVERWRITE = 0,
+    ORBIS_HTTP_HEADER_ADD = 1,
+};
+
+/// Host TCP connection with a receive buffer that the response parser consumes from.
+class HttpSocket {
+public:
+    explicit HttpSocket(net_socket sock);
+    ~HttpSocket();
+
+    HttpSocket(const HttpSocket&) = delete;
+    HttpSocket& operator=(const HttpSocket&) = delete;
+
+    /// Resolves host and connects, or returns an ORBIS_HTTP_ERROR code through error.
+    static std::unique_ptr<HttpSocket> Connect(const std::string& host, u16 port, u32 timeout_us,
+                                               int& error);
+
+    int Send(std::string_view data, u32 timeout_us);
+
+    /// Reads more data into the buffer. Returns the number of bytes read, 0 on EOF or an
+    /// ORBIS_HTTP_ERROR code. Non-blocking reads return ORBIS_HTTP_ERROR_EAGAIN when idle.
+    int Fill(bool block, u32 timeout_us);
+
+    std::string_view Buffered() const {
+        return std::string_view{buffer}.substr(read_pos);
+    }
+
+    void Consume(size_t size);
+
+    /// Unblocks any thread waiting on this socket.
+    void Shutdown();
+
+private:
+    net_socket sock;
+    std::string buffer;
+    size_t read_pos = 0;
+};
+
+/// Options that may be set on a template, connection or request and are inherited downwards.
+struct HttpSettings {
+    bool nonblock = false;
+    u32 connect_timeout_us = 30'000'000;
+    u32 send_timeout_us = 120'000'000;
+    u32 recv_timeout_us = 120'000'000;
+};
+
+struct HttpTemplate : HttpSettings {
+    std::string user_agent;
+    s32 http_version = ORBIS_HTTP_VERSION_1_1;
+
+    /// Returns an idle keep-alive socket to host:port, or nullptr when none is pooled.
+    std::unique_ptr<HttpSocket> AcquireSocket(const std::string& key);
+    void ReleaseSocket(const std::string& key, std::unique_ptr<HttpSocket> socket);
+
+private:
+    static constexpr size_t MaxIdleSocketsPerHost = 4;
+
+    std::mutex pool_mutex;
+    std::map<std::string, std::vector<std::unique_ptr<HttpSocket>>> idle_sockets;
+};
+
+struct HttpConnection : HttpSettings {
+    std::shared_ptr<HttpTemplate> tmpl;
+    std::string scheme;
+    std::string host;
+    u16 port;
+    bool keep_alive;
+
+    std::string PoolKey() const {
+        return host + ':' + std::to_string(port);
+    }
+};
+
+struct HttpRequest : HttpSettings {
+    enum class State : u32 {
+        Idle,
+        Sending,
+        Receiving,
+        Done,
+        Error,
+    };
+    enum class BodyMode : u32 {
+        None,
+        Length,
+        Chunked,
+        UntilClose,
+    };
+
+    std::shared_ptr<HttpConnection> connection;
+    std::string method;
+    std::string path;
+    u64 content_length;
+    std::vector<std::pair<std::string, std::string>> headers;
+    std::string post_data;
+
+    std::atomic<State> state{State::Idle};
+    std::atomic_bool aborted{false};
+    int error = 0;
+
+    s32 status_code = 0;
+    std::string response_headers;
+    s32 content_length_type = ORBIS_HTTP_CONTENTLEN_NOT_FOUND;
+    u64 response_content_length = 0;
+    BodyMode body_mode = BodyMode::None;
+    u64 body_remaining = 0;
+    bool chunk_needs_crlf = false;
+    bool chunk_in_trailer = false;
+    bool response_keep_alive = false;
+
+    std::mutex read_mutex;
+    std::mutex socket_mutex;
+    std::unique_ptr<HttpSocket> socket;
+
+    /// Connects, sends the request and parses the response header. Blocks.
+    int Perform();
+
+    /// Streams up to size bytes of the response body. Returns bytes read, 0 at the end of the
+    /// body or an ORBIS_HTTP_ERROR code.
+    int ReadBody(void* data, size_t size);
+
+    void Abort();
+
+private:
+    int SendAndReceiveHeader(bool allow_reuse, bool& reused);
+    int ParseHeader(std::string_view header);
+    int FillSocket(HttpSocket& sock, bool block);
+    int ReadChunkHeader(HttpSocket& sock, bool block);
+    int Fail(int result);
+    void FinishBody();
+};
+
+using HttpTemplatePtr = std::shared_ptr<HttpTemplate>;
+using HttpConnectionPtr = std::shared_ptr<HttpConnection>;
+using HttpRequestPtr = std::shared_ptr<HttpRequest>;
+
+/// Object tables for libSceHttp ids plus the worker that runs non-blocking requests.
+class HttpInternal {
+public:
+    HttpInternal();
+    ~HttpInternal();
+
+    int AddTemplate(HttpTemplatePtr tmpl);
+    int AddConnection(HttpConnectionPtr conn);
+    int AddRequest(HttpRequestPtr req);
+
+    HttpTemplatePtr FindTemplate(int id);
+    HttpConnectionPtr FindConnection(int id);
+    HttpRequestPtr FindRequest(int id);
+
+    /// Finds the settings block of a template, connection or request id.
+    std::shared_ptr<HttpSettings> FindSettings(int id);
+
+    bool RemoveTemplate(int id);
+    bool RemoveConnection(int id);
+    bool RemoveRequest(int id);
+
+    void QueueRequest(HttpRequestPtr req);
+
+private:
+    void IoThread(std::stop_token stoken);
+
+    std::mutex m_mutex;
+    std::map<int, HttpTemplatePtr> templates;
+    std::map<int, HttpConnectionPtr> connections;
+    std::map<int, HttpRequestPtr> requests;
+    int next_id = 0;
+
+    std::queue<HttpRequestPtr> io_queue;
+    std::mutex io_mutex;
+    std::condition_variable_any io_cv;
+    std::vector<std::jthread> io_threads;
+};
+
+} // namespace Libraries::Http
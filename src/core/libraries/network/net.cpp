@@ -17,6 +17,7 @@
 #include "core/libraries/error_codes.h"
 #include "core/libraries/libs.h"
 #include "core/libraries/network/net.h"
+#include "net_epoll.h"
 #include "net_error.h"
 #include "net_util.h"
 #include "netctl.h"
@@ -659,29 +660,107 @@ int PS4_SYSV_ABI sceNetDuplicateIpStop() {
     return ORBIS_OK;
 }
 
-int PS4_SYSV_ABI sceNetEpollAbort() {
-    LOG_ERROR(Lib_Net, "(STUBBED) called");
-    return ORBIS_OK;
+static int EpollError(int error) {
+    *sceNetErrnoLoc() = error & ~ORBIS_NET_ERROR_BASE;
+    return error;
 }
 
-int PS4_SYSV_ABI sceNetEpollControl() {
-    LOG_ERROR(Lib_Net, "(STUBBED) called");
+int PS4_SYSV_ABI sceNetEpollAbort(OrbisNetId eid, int flags) {
+    LOG_DEBUG(Lib_Net, "called eid = {} flags = {}", eid, flags);
+    auto* netcall = Common::Singleton<NetInternal>::Instance();
+    auto epoll = netcall->FindEpoll(eid);
+    if (!epoll) {
+        return EpollError(ORBIS_NET_ERROR_EBADF);
+    }
+    epoll->Abort();
     return ORBIS_OK;
 }
 
-int PS4_SYSV_ABI sceNetEpollCreate() {
-    LOG_DEBUG(Lib_Net, "(STUBBED) called");
-    return ORBIS_OK;
+int PS4_SYSV_ABI sceNetEpollControl(OrbisNetId eid, int op, OrbisNetId id,
+                                    OrbisNetEpollEvent* event) {
+    LOG_DEBUG(Lib_Net, "called eid = {} op = {} id = {}", eid, op, id);
+    auto* netcall = Common::Singleton<NetInternal>::Instance();
+    auto epoll = netcall->FindEpoll(eid);
+    if (!epoll) {
+        return EpollError(ORBIS_NET_ERROR_EBADF);
+    }
+    if (op != ORBIS_NET_EPOLL_CTL_DEL && !event) {
+        return EpollError(ORBIS_NET_ERROR_EFAULT);
+    }
+
+    int result;
+    switch (op) {
+    case ORBIS_NET_EPOLL_CTL_ADD: {
+        const auto sock = std::dynamic_pointer_cast<PosixSocket>(netcall->FindSocket(id));
+        if (!sock) {
+            LOG_WARNING(Lib_Net, "id = {} is not a host backed socket", id);
+            return EpollError(ORBIS_NET_ERROR_EBADF);
+        }
+        result = epoll->Add(id, sock->sock, *event);
+        break;
+    }
+    case ORBIS_NET_EPOLL_CTL_MOD:
+        result = epoll->Modify(id, *event);
+        break;
+    case ORBIS_NET_EPOLL_CTL_DEL:
+        result = epoll->Remove(id);
+        break;
+    default:
+        return EpollError(ORBIS_NET_ERROR_EINVAL);
+    }
+    return result < 0 ? EpollError(result) : result;
 }
 
-int PS4_SYSV_ABI sceNetEpollDestroy() {
-    LOG_DEBUG(Lib_Net, "(STUBBED) called");
+OrbisNetId PS4_SYSV_ABI sceNetEpollCreate(const char* name, int flags) {
+    LOG_DEBUG(Lib_Net, "called name = {} flags = {}", name ? name : "", flags);
+    if (flags != 0) {
+        return EpollError(ORBIS_NET_ERROR_EINVAL);
+    }
+    auto epoll = std::make_shared<Epoll>(name);
+    if (!epoll->IsValid()) {
+        return EpollError(ORBIS_NET_ERROR_EMFILE);
+    }
+    auto* netcall = Common::Singleton<NetInternal>::Instance();
+    std::scoped_lock lock{netcall->m_mutex};
+    const OrbisNetId eid = ++netcall->next_sock_id;
+    netcall->epolls.emplace(eid, std::move(epoll));
+    return eid;
+}
+
+int PS4_SYSV_ABI sceNetEpollDestroy(OrbisNetId eid) {
+    LOG_DEBUG(Lib_Net, "called eid = {}", eid);
+    auto* netcall = Common::Singleton<NetInternal>::Instance();
+    EpollPtr epoll;
+    {
+        std::scoped_lock lock{netcall->m_mutex};
+        const auto it = netcall->epolls.find(eid);
+        if (it == netcall->epolls.end()) {
+            return EpollError(ORBIS_NET_ERROR_EBADF);
+        }
+        epoll = std::move(it->second);
+        netcall->epolls.erase(it);
+    }
+    // Waiters keep their own reference, wake them so the host objects can be released.
+    epoll->Abort();
     return ORBIS_OK;
 }
 
-int PS4_SYSV_ABI sceNetEpollWait() {
-    LOG_TRACE(Lib_Net, "(STUBBED) called");
-    return ORBIS_OK;
+int PS4_SYSV_ABI sceNetEpollWait(OrbisNetId eid, OrbisNetEpollEvent* events, int maxevents,
+                                 int timeout) {
+    LOG_TRACE(Lib_Net, "called eid = {} maxevents = {} timeout = {}", eid, maxevents, timeout);
+    auto* netcall = Common::Singleton<NetInternal>::Instance();
+    auto epoll = netcall->FindEpoll(eid);
+    if (!epoll) {
+        return EpollError(ORBIS_NET_ERROR_EBADF);
+    }
+    if (!events) {
+        return EpollError(ORBIS_NET_ERROR_EFAULT);
+    }
+    if (maxevents <= 0) {
+        return EpollError(ORBIS_NET_ERROR_EINVAL);
+    }
+    const int result = epoll->Wait(events, maxevents, timeout);
+    return result < 0 ? EpollError(result) : result;
 }
 
 int* PS4_SYSV_ABI sceNetErrnoLoc() {
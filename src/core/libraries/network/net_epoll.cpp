@@ -0,0 +1,298 @@
+// SPDX-FileCopyrightText: Copyright 2025 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#elif !defined(_WIN32)
+#include <poll.h>
+#endif
+
+#include "common/logging/log.h"
+#include "core/libraries/error_codes.h"
+#include "net_epoll.h"
+#include "net_error.h"
+
+namespace Libraries::Net {
+
+namespace {
+
+/// Upper bound on the number of events collected by a single host wait.
+constexpr int MaxWaitEvents = 64;
+
+#ifdef __linux__
+/// Host epoll user data reserved for the abort eventfd.
+constexpr u64 AbortEventData = ~0ULL;
+
+u32 ToHostEvents(u32 events) {
+    u32 host_events = 0;
+    if (events & ORBIS_NET_EPOLLIN) {
+        host_events |= EPOLLIN;
+    }
+    if (events & ORBIS_NET_EPOLLOUT) {
+        host_events |= EPOLLOUT;
+    }
+    return host_events;
+}
+
+u32 FromHostEvents(u32 host_events) {
+    u32 events = 0;
+    if (host_events & EPOLLIN) {
+        events |= ORBIS_NET_EPOLLIN;
+    }
+    if (host_events & EPOLLOUT) {
+        events |= ORBIS_NET_EPOLLOUT;
+    }
+    if (host_events & EPOLLERR) {
+        events |= ORBIS_NET_EPOLLERR;
+    }
+    if (host_events & (EPOLLHUP | EPOLLRDHUP)) {
+        events |= ORBIS_NET_EPOLLHUP;
+    }
+    return events;
+}
+#else
+/// Longest single host poll, bounds how long a waiter takes to notice aborts and new sockets.
+constexpr int PollSliceMs = 10;
+
+short ToHostEvents(u32 events) {
+    short host_events = 0;
+    if (events & ORBIS_NET_EPOLLIN) {
+        host_events |= POLLIN;
+    }
+    if (events & ORBIS_NET_EPOLLOUT) {
+        host_events |= POLLOUT;
+    }
+    return host_events;
+}
+
+u32 FromHostEvents(short host_events) {
+    u32 events = 0;
+    if (host_events & POLLIN) {
+        events |= ORBIS_NET_EPOLLIN;
+    }
+    if (host_events & POLLOUT) {
+        events |= ORBIS_NET_EPOLLOUT;
+    }
+    if (host_events & POLLERR) {
+        events |= ORBIS_NET_EPOLLERR;
+    }
+    if (host_events & POLLHUP) {
+        events |= ORBIS_NET_EPOLLHUP;
+    }
+    return events;
+}
+#endif
+
+} // Anonymous namespace
+
+Epoll::Epoll(const char* name_) : name{name_ ? name_ : ""} {
+#ifdef __linux__
+    epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    abort_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (epoll_fd < 0 || abort_fd < 0) {
+        LOG_ERROR(Lib_Net, "Failed to create host epoll for {}: errno={}", name, errno);
+        return;
+    }
+    epoll_event abort_event{};
+    abort_event.events = EPOLLIN;
+    abort_event.data.u64 = AbortEventData;
+    epoll_ctl(epoll_fd, EPOLL_CTL_ADD, abort_fd, &abort_event);
+#endif
+}
+
+Epoll::~Epoll() {
+#ifdef __linux__
+    if (epoll_fd >= 0) {
+        close(epoll_fd);
+    }
+    if (abort_fd >= 0) {
+        close(abort_fd);
+    }
+#endif
+}
+
+bool Epoll::IsValid() const {
+#ifdef __linux__
+    return epoll_fd >= 0 && abort_fd >= 0;
+#else
+    return true;
+#endif
+}
+
+int Epoll::Add(OrbisNetId id, net_socket sock, const OrbisNetEpollEvent& event) {
+    std::scoped_lock lock{m_mutex};
+    if (registrations.contains(id)) {
+        return ORBIS_NET_ERROR_EEXIST;
+    }
+#ifdef __linux__
+    epoll_event host_event{};
+    host_event.events = ToHostEvents(event.events) | EPOLLRDHUP;
+    host_event.data.u64 = static_cast<u32>(id);
+    if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, sock, &host_event) < 0) {
+        LOG_ERROR(Lib_Net, "Failed to add socket {} to {}: errno={}", id, name, errno);
+        return errno == EPERM ? ORBIS_NET_ERROR_EOPNOTSUPP : ORBIS_NET_ERROR_EBADF;
+    }
+#endif
+    registrations.emplace(id, Registration{sock, event.events, event.data});
+    return ORBIS_OK;
+}
+
+int Epoll::Modify(OrbisNetId id, const OrbisNetEpollEvent& event) {
+    std::scoped_lock lock{m_mutex};
+    const auto it = registrations.find(id);
+    if (it == registrations.end()) {
+        return ORBIS_NET_ERROR_ENOENT;
+    }
+#ifdef __linux__
+    epoll_event host_event{};
+    host_event.events = ToHostEvents(event.events) | EPOLLRDHUP;
+    host_event.data.u64 = static_cast<u32>(id);
+    if (epoll_ctl(epoll_fd, EPOLL_CTL_MOD, it->second.sock, &host_event) < 0) {
+        LOG_ERROR(Lib_Net, "Failed to modify socket {} in {}: errno={}", id, name, errno);
+        return ORBIS_NET_ERROR_EBADF;
+    }
+#endif
+    it->second.events = event.events;
+    it->second.data = event.data;
+    return ORBIS_OK;
+}
+
+int Epoll::Remove(OrbisNetId id) {
+    std::scoped_lock lock{m_mutex};
+    const auto it = registrations.find(id);
+    if (it == registrations.end()) {
+        return ORBIS_NET_ERROR_ENOENT;
+    }
+#ifdef __linux__
+    // The host socket may already be closed, in which case the kernel dropped it on its own.
+    epoll_ctl(epoll_fd, EPOLL_CTL_DEL, it->second.sock, nullptr);
+#endif
+    registrations.erase(it);
+    return ORBIS_OK;
+}
+
+int Epoll::Wait(OrbisNetEpollEvent* events, int maxevents, int timeout) {
+    if (aborted) {
+        return ORBIS_NET_ERROR_ECANCELED;
+    }
+#ifdef __linux__
+    std::array<epoll_event, MaxWaitEvents> host_events;
+    const int timeout_ms = timeout < 0 ? -1 : (timeout + 999) / 1000;
+    const int ret = epoll_wait(epoll_fd, host_events.data(), std::min(maxevents, MaxWaitEvents),
+                               timeout_ms);
+    if (aborted) {
+        return ORBIS_NET_ERROR_ECANCELED;
+    }
+    if (ret < 0) {
+        return errno == EINTR ? ORBIS_NET_ERROR_EINTR : ORBIS_NET_ERROR_EINVAL;
+    }
+
+    std::scoped_lock lock{m_mutex};
+    int count = 0;
+    for (int i = 0; i < ret; i++) {
+        if (host_events[i].data.u64 == AbortEventData) {
+            continue;
+        }
+        const auto id = static_cast<OrbisNetId>(host_events[i].data.u64);
+        const auto it = registrations.find(id);
+        if (it == registrations.end()) {
+            // Removed by another thread while we were waiting.
+            continue;
+        }
+        const u32 ready = FromHostEvents(host_events[i].events) &
+                          (it->second.events | ORBIS_NET_EPOLLERR | ORBIS_NET_EPOLLHUP);
+        events[count++] = OrbisNetEpollEvent{
+            .events = ready,
+            .reserved = 0,
+            .ident = static_cast<u64>(id),
+            .data = it->second.data,
+        };
+    }
+    return count;
+#else
+    using Clock = std::chrono::steady_clock;
+    const auto deadline = timeout < 0 ? Clock::time_point::max()
+                                      : Clock::now() + std::chrono::microseconds(timeout);
+    std::vector<pollfd> fds;
+    std::vector<OrbisNetId> ids;
+    while (true) {
+        // Registrations may change between slices, rebuild the host set every time.
+        {
+            std::scoped_lock lock{m_mutex};
+            fds.clear();
+            ids.clear();
+            for (const auto& [id, reg] : registrations) {
+                fds.push_back(pollfd{.fd = reg.sock, .events = ToHostEvents(reg.events)});
+                ids.push_back(id);
+            }
+        }
+
+        int slice_ms = PollSliceMs;
+        if (timeout >= 0) {
+            const auto remaining = std::chrono::ceil<std::chrono::milliseconds>(
+                deadline - Clock::now());
+            slice_ms = std::clamp(static_cast<int>(remaining.count()), 0, PollSliceMs);
+        }
+
+        int ret = 0;
+        if (fds.empty()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(slice_ms));
+        } else {
+#ifdef _WIN32
+            ret = WSAPoll(fds.data(), static_cast<ULONG>(fds.size()), slice_ms);
+#else
+            ret = poll(fds.data(), static_cast<nfds_t>(fds.size()), slice_ms);
+            if (ret < 0 && errno == EINTR) {
+                ret = 0;
+            }
+#endif
+        }
+        if (aborted) {
+            return ORBIS_NET_ERROR_ECANCELED;
+        }
+        if (ret < 0) {
+            return ORBIS_NET_ERROR_EINVAL;
+        }
+        if (ret > 0) {
+            std::scoped_lock lock{m_mutex};
+            int count = 0;
+            for (size_t i = 0; i < fds.size() && count < maxevents; i++) {
+                const auto it = registrations.find(ids[i]);
+                if (fds[i].revents == 0 || (fds[i].revents & POLLNVAL) ||
+                    it == registrations.end()) {
+                    continue;
+                }
+                events[count++] = OrbisNetEpollEvent{
+                    .events = FromHostEvents(fds[i].revents),
+                    .reserved = 0,
+                    .ident = static_cast<u64>(ids[i]),
+                    .data = it->second.data,
+                };
+            }
+            if (count > 0) {
+                return count;
+            }
+        }
+        if (timeout >= 0 && Clock::now() >= deadline) {
+            return 0;
+        }
+    }
+#endif
+}
+
+void Epoll::Abort() {
+    aborted = true;
+#ifdef __linux__
+    const u64 value = 1;
+    [[maybe_unused]] const auto written = write(abort_fd, &value, sizeof(value));
+#endif
+}
+
+} // namespace Libraries::Net
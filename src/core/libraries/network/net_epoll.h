@@ -0,0 +1,50 @@
+// SPDX-FileCopyrightText: Copyright 2025 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <string>
+#include "sockets.h"
+
+namespace Libraries::Net {
+
+/// Guest epoll object. Registered sockets are forwarded to a host epoll instance on Linux and
+/// polled in short slices elsewhere, so waits block in the host kernel instead of spinning.
+struct Epoll {
+    explicit Epoll(const char* name);
+    ~Epoll();
+
+    bool IsValid() const;
+
+    int Add(OrbisNetId id, net_socket sock, const OrbisNetEpollEvent& event);
+    int Modify(OrbisNetId id, const OrbisNetEpollEvent& event);
+    int Remove(OrbisNetId id);
+
+    /// Blocks for up to timeout microseconds (-1 waits forever) and returns the number of ready
+    /// events or an ORBIS_NET_ERROR code.
+    int Wait(OrbisNetEpollEvent* events, int maxevents, int timeout);
+
+    /// Wakes up all current waiters and makes any further wait fail with ECANCELED.
+    void Abort();
+
+private:
+    struct Registration {
+        net_socket sock;
+        u32 events;
+        OrbisNetEpollData data;
+    };
+
+    std::string name;
+    std::mutex m_mutex;
+    std::map<OrbisNetId, Registration> registrations;
+    std::atomic_bool aborted{false};
+#ifdef __linux__
+    int epoll_fd = -1;
+    int abort_fd = -1;
+#endif
+};
+
+} // namespace Libraries::Net
@@ -21,6 +21,8 @@ typedef int socklen_t;
 #include <unistd.h>
 typedef int net_socket;
 #endif
+#include <array>
+#include <atomic>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -29,8 +31,10 @@ typedef int net_socket;
 namespace Libraries::Net {
 
 struct Socket;
+struct Epoll;
 
 typedef std::shared_ptr<Socket> SocketPtr;
+typedef std::shared_ptr<Epoll> EpollPtr;
 
 struct OrbisNetLinger {
     s32 l_onoff;
@@ -51,6 +55,8 @@ struct Socket {
                               u32* fromlen) = 0;
     virtual int Connect(const OrbisNetSockaddr* addr, u32 namelen) = 0;
     virtual int GetSocketAddress(OrbisNetSockaddr* name, u32* namelen) = 0;
+    /// Guards emulated socket state such as options. Data transfer relies on the host socket
+    /// being thread safe and does not take it.
     std::mutex m_mutex;
 };
 
@@ -101,20 +107,77 @@ struct P2PSocket : public Socket {
 class NetInternal {
 public:
     explicit NetInternal() = default;
-    ~NetInternal() = default;
+    ~NetInternal() {
+        for (auto& chunk : slot_chunks) {
+            delete chunk.load(std::memory_order_relaxed);
+        }
+    }
+
+    /// Looks up a socket without taking any lock. Ids are never reused and a slot is written
+    /// exactly once before it is published, so readers only need an acquire load.
     SocketPtr FindSocket(int sockid) {
+        if (sockid <= 0 || sockid >= MaxSockets) {
+            return nullptr;
+        }
+        const SlotChunk* chunk =
+            slot_chunks[sockid >> SlotChunkBits].load(std::memory_order_acquire);
+        if (!chunk) {
+            return nullptr;
+        }
+        const Slot& slot = (*chunk)[sockid & SlotChunkMask];
+        if (!slot.published.load(std::memory_order_acquire)) {
+            return nullptr;
+        }
+        return slot.sock;
+    }
+
+    /// Publishes a new socket and returns its id, or -1 when the table is full.
+    int AddSocket(SocketPtr sock) {
         std::scoped_lock lock{m_mutex};
-        const auto it = socks.find(sockid);
-        if (it != socks.end()) {
+        const int id = next_sock_id + 1;
+        if (id >= MaxSockets) {
+            return -1;
+        }
+        next_sock_id = id;
+        auto& chunk_ptr = slot_chunks[id >> SlotChunkBits];
+        SlotChunk* chunk = chunk_ptr.load(std::memory_order_relaxed);
+        if (!chunk) {
+            chunk = new SlotChunk{};
+            chunk_ptr.store(chunk, std::memory_order_release);
+        }
+        Slot& slot = (*chunk)[id & SlotChunkMask];
+        slot.sock = std::move(sock);
+        slot.published.store(true, std::memory_order_release);
+        return id;
+    }
+
+    EpollPtr FindEpoll(int eid) {
+        std::scoped_lock lock{m_mutex};
+        const auto it = epolls.find(eid);
+        if (it != epolls.end()) {
             return it->second;
         }
-        return 0;
+        return nullptr;
     }
 
+private:
+    static constexpr int SlotChunkBits = 8;
+    static constexpr int SlotChunkMask = (1 << SlotChunkBits) - 1;
+    static constexpr int MaxSlotChunks = 1024;
+    static constexpr int MaxSockets = MaxSlotChunks << SlotChunkBits;
+
+    struct Slot {
+        SocketPtr sock;
+        std::atomic_bool published{false};
+    };
+    using SlotChunk = std::array<Slot, 1 << SlotChunkBits>;
+
+    std::array<std::atomic<SlotChunk*>, MaxSlotChunks> slot_chunks{};
+
 public:
     std::mutex m_mutex;
-    typedef std::map<int, SocketPtr> NetSockets;
-    NetSockets socks;
+    typedef std::map<int, EpollPtr> NetEpolls;
+    NetEpolls epolls;
     int next_sock_id = 0;
 };
 } // namespace Libraries::Net
\ No newline at end of file
@@ -57,8 +57,12 @@ int PS4_SYSV_ABI sys_accept(OrbisNetId s, OrbisNetSockaddr* addr, u32* paddrlen)
         LOG_DEBUG(Lib_Net, "error creating new socket for accepting");
         return -1;
     }
-    auto id = ++netcall->next_sock_id;
-    netcall->socks.emplace(id, new_sock);
+    auto id = netcall->AddSocket(new_sock);
+    if (id < 0) {
+        new_sock->Close();
+        *Libraries::Kernel::__Error() = ORBIS_NET_EMFILE;
+        return -1;
+    }
     return id;
 }
 int PS4_SYSV_ABI sys_getpeername(OrbisNetId s, const OrbisNetSockaddr* addr, u32* paddrlen) {
@@ -156,8 +160,12 @@ int PS4_SYSV_ABI sys_socketex(const char* name, int family, int type, int protoc
         UNREACHABLE_MSG("Unknown type {}", type);
     }
     auto* netcall = Common::Singleton<NetInternal>::Instance();
-    auto id = ++netcall->next_sock_id;
-    netcall->socks.emplace(id, sock);
+    auto id = netcall->AddSocket(sock);
+    if (id < 0) {
+        sock->Close();
+        *Libraries::Kernel::__Error() = ORBIS_NET_EMFILE;
+        return -1;
+    }
     return id;
 }
 int PS4_SYSV_ABI sys_socket(int family, int type, int protocol) {
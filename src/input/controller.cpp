@@ -4,6 +4,7 @@
 #include <SDL3/SDL.h>
 #include "common/config.h"
 #include "common/logging/log.h"
+#include "core/debug_state.h"
 #include "core/libraries/kernel/time.h"
 #include "core/libraries/pad/pad.h"
 #include "input/controller.h"
@@ -60,13 +61,10 @@ void State::OnAccel(const float accel[3]) {
 }
 
 GameController::GameController() {
-    m_states_num = 0;
     m_last_state = State();
 }
 
 void GameController::ReadState(State* state, bool* isConnected, int* connectedCount) {
-    std::scoped_lock lock{m_mutex};
-
     *isConnected = m_connected;
     *connectedCount = m_connected_count;
     *state = GetLastState();
@@ -74,59 +72,107 @@ void GameController::ReadState(State* state, bool* isConnected, int* connectedCo
 
 int GameController::ReadStates(State* states, int states_num, bool* isConnected,
                                int* connectedCount) {
-    std::scoped_lock lock{m_mutex};
-
     *isConnected = m_connected;
     *connectedCount = m_connected_count;
 
-    int ret_num = 0;
+    if (!m_connected || states_num <= 0) {
+        return 0;
+    }
 
-    if (m_connected) {
-        if (m_states_num == 0) {
-            ret_num = 1;
-            states[0] = m_last_state;
-        } else {
-            for (uint32_t i = 0; i < m_states_num; i++) {
-                if (ret_num >= states_num) {
-                    break;
-                }
-                auto index = (m_first_state + i) % MAX_STATES;
-                if (!m_private[index].obtained) {
-                    m_private[index].obtained = true;
-
-                    states[ret_num++] = m_states[index];
-                }
-            }
-        }
+    const u64 write_index = m_write_index.load(std::memory_order_acquire);
+    if (write_index == 0) {
+        states[0] = State();
+        return 1;
     }
 
+    // Claim the range of samples not handed out yet. The oldest slot may be in the middle of
+    // being overwritten, so it is left out of the window.
+    const u64 oldest = write_index > MAX_STATES - 1 ? write_index - (MAX_STATES - 1) : 0;
+    u64 read_index = m_read_index.load(std::memory_order_acquire);
+    u64 begin;
+    u64 end;
+    do {
+        begin = std::max(read_index, oldest);
+        end = std::min<u64>(write_index, begin + states_num);
+        if (begin >= end) {
+            return 0;
+        }
+    } while (!m_read_index.compare_exchange_weak(read_index, end, std::memory_order_acq_rel));
+
+    int ret_num = 0;
+    for (u64 i = begin; i < end; i++) {
+        bool repeated;
+        if (LoadState(i, states[ret_num], repeated)) {
+            MeasureLatency(i, states[ret_num], repeated);
+            ret_num++;
+        }
+    }
     return ret_num;
 }
 
 State GameController::GetLastState() const {
-    if (m_states_num == 0) {
-        return m_last_state;
+    State state;
+    while (true) {
+        const u64 write_index = m_write_index.load(std::memory_order_acquire);
+        if (write_index == 0) {
+            return state;
+        }
+        bool repeated;
+        if (LoadState(write_index - 1, state, repeated)) {
+            MeasureLatency(write_index - 1, state, repeated);
+            return state;
+        }
     }
-    const u32 last = (m_first_state + m_states_num - 1) % MAX_STATES;
-    return m_states[last];
 }
 
-void GameController::AddState(const State& state) {
-    if (m_states_num >= MAX_STATES) {
-        m_states_num = MAX_STATES - 1;
-        m_first_state = (m_first_state + 1) % MAX_STATES;
+bool GameController::LoadState(u64 index, State& state, bool& repeated) const {
+    const auto& slot = m_states[index % MAX_STATES];
+    while (true) {
+        const u32 sequence = slot.sequence.load(std::memory_order_acquire);
+        if (sequence & 1) {
+            continue;
+        }
+        const u64 slot_index = slot.index;
+        repeated = slot.repeated;
+        state = slot.state;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) == sequence) {
+            // The slot may have been reused for a newer sample since the index was sampled.
+            return slot_index == index;
+        }
     }
+}
+
+void GameController::MeasureLatency(u64 index, const State& state, bool repeated) const {
+    // Only the first read of a sample produced by actual input counts.
+    u64 measured = m_latency_index.load(std::memory_order_relaxed);
+    if (repeated || index < measured ||
+        !m_latency_index.compare_exchange_strong(measured, index + 1,
+                                                 std::memory_order_relaxed)) {
+        return;
+    }
+    const u64 now = Libraries::Kernel::sceKernelGetProcessTime();
+    DebugState.RecordInputLatency(now > state.time ? now - state.time : 0);
+}
+
+void GameController::AddState(const State& state, bool repeated) {
+    const u64 index = m_write_index.load(std::memory_order_relaxed);
+    auto& slot = m_states[index % MAX_STATES];
+    const u32 sequence = slot.sequence.load(std::memory_order_relaxed);
+    slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.index = index;
+    slot.repeated = repeated;
+    slot.state = state;
+    slot.sequence.store(sequence + 2, std::memory_order_release);
 
-    const u32 index = (m_first_state + m_states_num) % MAX_STATES;
-    m_states[index] = state;
     m_last_state = state;
-    m_private[index].obtained = false;
-    m_states_num++;
+    m_write_index.store(index + 1, std::memory_order_release);
 }
 
 void GameController::CheckButton(int id, OrbisPadButtonDataOffset button, bool is_pressed) {
-    std::scoped_lock lock{m_mutex};
-    auto state = GetLastState();
+    std::scoped_lock lock{m_write_mutex};
+    auto state = m_last_state;
 
     state.time = Libraries::Kernel::sceKernelGetProcessTime();
     state.OnButton(button, is_pressed);
@@ -135,8 +181,8 @@ void GameController::CheckButton(int id, OrbisPadButtonDataOffset button, bool i
 }
 
 void GameController::Axis(int id, Input::Axis axis, int value) {
-    std::scoped_lock lock{m_mutex};
-    auto state = GetLastState();
+    std::scoped_lock lock{m_write_mutex};
+    auto state = m_last_state;
 
     state.time = Libraries::Kernel::sceKernelGetProcessTime();
     state.OnAxis(axis, value);
@@ -145,8 +191,8 @@ void GameController::Axis(int id, Input::Axis axis, int value) {
 }
 
 void GameController::Gyro(int id, const float gyro[3]) {
-    std::scoped_lock lock{m_mutex};
-    auto state = GetLastState();
+    std::scoped_lock lock{m_write_mutex};
+    auto state = m_last_state;
     state.time = Libraries::Kernel::sceKernelGetProcessTime();
 
     // Update the angular velocity (gyro data)
@@ -155,8 +201,8 @@ void GameController::Gyro(int id, const float gyro[3]) {
     AddState(state);
 }
 void GameController::Acceleration(int id, const float acceleration[3]) {
-    std::scoped_lock lock{m_mutex};
-    auto state = GetLastState();
+    std::scoped_lock lock{m_write_mutex};
+    auto state = m_last_state;
     state.time = Libraries::Kernel::sceKernelGetProcessTime();
 
     // Update the acceleration values
@@ -218,8 +264,8 @@ void GameController::SetVibration(u8 smallMotor, u8 largeMotor) {
 
 void GameController::SetTouchpadState(int touchIndex, bool touchDown, float x, float y) {
     if (touchIndex < 2) {
-        std::scoped_lock lock{m_mutex};
-        auto state = GetLastState();
+        std::scoped_lock lock{m_write_mutex};
+        auto state = m_last_state;
 
         state.time = Libraries::Kernel::sceKernelGetProcessTime();
         state.OnTouchpad(touchIndex, touchDown, x, y);
@@ -229,22 +275,18 @@ void GameController::SetTouchpadState(int touchIndex, bool touchDown, float x, f
 }
 
 u8 GameController::GetTouchCount() {
-    std::scoped_lock lock{m_mutex};
     return m_touch_count;
 }
 
 void GameController::SetTouchCount(u8 touchCount) {
-    std::scoped_lock lock{m_mutex};
     m_touch_count = touchCount;
 }
 
 u8 GameController::GetSecondaryTouchCount() {
-    std::scoped_lock lock{m_mutex};
     return m_secondary_touch_count;
 }
 
 void GameController::SetSecondaryTouchCount(u8 touchCount) {
-    std::scoped_lock lock{m_mutex};
     m_secondary_touch_count = touchCount;
     if (touchCount == 0) {
         m_was_secondary_reset = true;
@@ -252,22 +294,18 @@ void GameController::SetSecondaryTouchCount(u8 touchCount) {
 }
 
 u8 GameController::GetPreviousTouchNum() {
-    std::scoped_lock lock{m_mutex};
     return m_previous_touchnum;
 }
 
 void GameController::SetPreviousTouchNum(u8 touchNum) {
-    std::scoped_lock lock{m_mutex};
     m_previous_touchnum = touchNum;
 }
 
 bool GameController::WasSecondaryTouchReset() {
-    std::scoped_lock lock{m_mutex};
     return m_was_secondary_reset;
 }
 
 void GameController::UnsetSecondaryTouchResetBool() {
-    std::scoped_lock lock{m_mutex};
     m_was_secondary_reset = false;
 }
 
@@ -305,19 +343,13 @@ Engine* GameController::GetEngine() {
 
 u32 GameController::Poll() {
     if (m_connected) {
-        std::scoped_lock lock{m_mutex};
+        std::scoped_lock lock{m_write_mutex};
         auto time = Libraries::Kernel::sceKernelGetProcessTime();
-        if (m_states_num == 0) {
-            auto diff = (time - m_last_state.time) / 1000;
-            if (diff >= 100) {
-                AddState(GetLastState());
-            }
-        } else {
-            auto index = (m_first_state - 1 + m_states_num) % MAX_STATES;
-            auto diff = (time - m_states[index].time) / 1000;
-            if (m_private[index].obtained && diff >= 100) {
-                AddState(GetLastState());
-            }
+        const bool obtained = m_read_index.load(std::memory_order_acquire) >=
+                              m_write_index.load(std::memory_order_relaxed);
+        auto diff = (time - m_last_state.time) / 1000;
+        if (obtained && diff >= 100) {
+            AddState(m_last_state, true);
         }
     }
     return 100;
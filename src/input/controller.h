@@ -4,6 +4,9 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <memory>
 #include <mutex>
 #include "common/types.h"
@@ -72,7 +75,8 @@ public:
     int ReadStates(State* states, int states_num, bool* isConnected, int* connectedCount);
     State GetLastState() const;
     void CheckButton(int id, Libraries::Pad::OrbisPadButtonDataOffset button, bool isPressed);
-    void AddState(const State& state);
+    /// Publishes a new state to readers. Must be called with m_write_mutex held.
+    void AddState(const State& state, bool repeated = false);
     void Axis(int id, Input::Axis axis, int value);
     void Gyro(int id, const float gyro[3]);
     void Acceleration(int id, const float acceleration[3]);
@@ -103,23 +107,31 @@ public:
                                      Libraries::Pad::OrbisFQuaternion& orientation);
 
 private:
-    struct StateInternal {
-        bool obtained = false;
+    /// Entry of the state history. The input thread writes it under a sequence lock, so guest
+    /// threads polling the pad never wait on input delivery.
+    struct StateSlot {
+        std::atomic<u32> sequence{0};
+        u64 index = 0;
+        bool repeated = false;
+        State state;
     };
 
+    bool LoadState(u64 index, State& state, bool& repeated) const;
+    void MeasureLatency(u64 index, const State& state, bool repeated) const;
+
     std::mutex m_mutex;
+    std::mutex m_write_mutex;
     bool m_connected = true;
     State m_last_state;
     int m_connected_count = 0;
-    u32 m_states_num = 0;
-    u32 m_first_state = 0;
-    u8 m_touch_count = 0;
-    u8 m_secondary_touch_count = 0;
-    u8 m_previous_touch_count = 0;
-    u8 m_previous_touchnum = 0;
-    bool m_was_secondary_reset = false;
-    std::array<State, MAX_STATES> m_states;
-    std::array<StateInternal, MAX_STATES> m_private;
+    std::atomic<u64> m_write_index = 0;
+    std::atomic<u64> m_read_index = 0;
+    mutable std::atomic<u64> m_latency_index = 0;
+    std::atomic<u8> m_touch_count = 0;
+    std::atomic<u8> m_secondary_touch_count = 0;
+    std::atomic<u8> m_previous_touchnum = 0;
+    std::atomic_bool m_was_secondary_reset = false;
+    std::array<StateSlot, MAX_STATES> m_states;
     std::chrono::steady_clock::time_point m_last_update = {};
     Libraries::Pad::OrbisFQuaternion m_orientation = {0.0f, 0.0f, 0.0f, 1.0f};
 
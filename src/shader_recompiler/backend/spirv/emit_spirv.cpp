@@ -153,6 +153,10 @@ void Traverse(EmitContext& ctx, const IR::Program& program) {
             ctx.AddLabel(label);
             for (IR::Inst& inst : node.data.block->Instructions()) {
                 EmitInst(ctx, &inst);
+                if (program.uniform_values.contains(&inst) &&
+                    Sirit::ValidId(inst.Definition<Id>())) {
+                    ctx.Decorate(inst.Definition<Id>(), spv::Decoration::Uniform);
+                }
             }
             ctx.first_to_last_label_map[label.value] = ctx.last_label;
             break;
@@ -135,6 +135,33 @@ struct PushData {
 static_assert(sizeof(PushData) <= 128,
               "PushData size is greater than minimum size guaranteed by Vulkan spec");
 
+/**
+ * Compute kernel recognized by its structure that the renderer can replace with a transfer
+ * command. Byte offsets are an affine function of the invocation ids.
+ */
+struct HleSignature {
+    enum class Type : u32 {
+        None,
+        FillBuffer,
+        CopyBuffer,
+    };
+
+    struct Access {
+        u32 buffer;                      ///< Index into Info::buffers.
+        u32 sharp_stride;                ///< Buffer stride the addressing was compiled for.
+        std::array<s64, 3> local_stride; ///< Bytes per step of each local invocation id.
+        std::array<s64, 3> group_stride; ///< Bytes per step of each workgroup id.
+        s64 offset;
+    };
+
+    Type type{};
+    u32 element_size{}; ///< Bytes accessed by every invocation.
+    Access dst{};
+    Access src{};
+    u32 fill_value{};
+    IR::ScalarReg fill_reg{IR::ScalarReg::Max}; ///< User data holding the value, if not constant.
+};
+
 /**
  * Contains general information generated by the shader recompiler for an input program.
  */
@@ -235,6 +262,7 @@ struct Info {
     };
     ReadConstType readconst_types{};
     IR::Type dma_types{IR::Type::Void};
+    HleSignature hle{};
 
     explicit Info(Stage stage_, LogicalStage l_stage_, ShaderParams params)
         : stage{stage_}, l_stage{l_stage_}, pgm_hash{params.hash}, pgm_base{params.Base()},
@@ -50,6 +50,16 @@ void Block::AddBranch(Block* block) {
     block->imm_predecessors.push_back(this);
 }
 
+void Block::RemoveBranch(Block* block) {
+    std::erase(imm_successors, block);
+    std::erase(block->imm_predecessors, this);
+    for (Inst& inst : block->instructions) {
+        if (inst.GetOpcode() == Opcode::Phi) {
+            inst.ErasePhiOperand(this);
+        }
+    }
+}
+
 static std::string BlockToIndex(const std::map<const Block*, size_t>& block_to_index,
                                 Block* block) {
     if (const auto it{block_to_index.find(block)}; it != block_to_index.end()) {
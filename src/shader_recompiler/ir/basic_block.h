@@ -46,6 +46,8 @@ public:
 
     /// Adds a new branch to this basic block.
     void AddBranch(Block* block);
+    /// Removes a branch from this basic block, along with its operands in the target's phis.
+    void RemoveBranch(Block* block);
 
     /// Gets a mutable reference to the instruction list for this basic block.
     [[nodiscard]] InstructionList& Instructions() noexcept {
@@ -169,6 +169,29 @@ void Inst::AddPhiOperand(Block* predecessor, const Value& value) {
     phi_args.emplace_back(predecessor, value);
 }
 
+void Inst::ErasePhiOperand(Block* predecessor) {
+    if (op != Opcode::Phi) {
+        UNREACHABLE_MSG("{} is not a Phi instruction", op);
+    }
+    const auto it = std::ranges::find(phi_args, predecessor, &std::pair<Block*, Value>::first);
+    if (it == phi_args.end()) {
+        return;
+    }
+    const size_t index = std::distance(phi_args.begin(), it);
+    if (!it->second.IsImmediate()) {
+        UndoUse(it->second.Inst(), index);
+    }
+    phi_args.erase(it);
+    // Uses record the operand index, shift the ones after the erased operand down.
+    for (size_t i = index; i < phi_args.size(); i++) {
+        const Value& value{phi_args[i].second};
+        if (!value.IsImmediate()) {
+            UndoUse(value.Inst(), i + 1);
+            Use(value.Inst(), i);
+        }
+    }
+}
+
 void Inst::Invalidate() {
     ClearArgs();
     ReplaceOpcode(Opcode::Void);
@@ -0,0 +1,298 @@
+// SPDX-FileCopyrightText: Copyright 2025 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <optional>
+#include <unordered_set>
+#include <vector>
+#include "shader_recompiler/ir/post_order.h"
+#include "shader_recompiler/ir/program.h"
+
+namespace Shader::Optimization {
+
+// Folds structured branches whose condition became constant and merges straight-line block
+// chains, keeping the abstract syntax list, block edges and phis in sync so the SPIR-V emitter
+// sees an ordinary structured program.
+
+namespace {
+
+using NodeType = IR::AbstractSyntaxNode::Type;
+
+std::optional<bool> ConstantCondition(const IR::U1& cond) {
+    IR::Value value{cond.Resolve()};
+    if (!value.IsImmediate()) {
+        const IR::Inst* inst{value.InstRecursive()};
+        if (inst->GetOpcode() != IR::Opcode::ConditionRef) {
+            return std::nullopt;
+        }
+        value = inst->Arg(0).Resolve();
+        if (!value.IsImmediate()) {
+            return std::nullopt;
+        }
+    }
+    return value.U1();
+}
+
+/// Drops the ConditionRef that kept a folded branch condition alive.
+void ReleaseCondition(const IR::U1& cond) {
+    const IR::Value value{cond};
+    if (!value.IsImmediate() && value.InstRecursive()->GetOpcode() == IR::Opcode::ConditionRef) {
+        value.InstRecursive()->Invalidate();
+    }
+}
+
+/// Block whose instructions precede a control flow node, the nearest block node before it.
+IR::Block* HeaderBlock(const IR::AbstractSyntaxList& syntax_list, size_t index) {
+    while (index-- > 0) {
+        if (syntax_list[index].type == NodeType::Block) {
+            return syntax_list[index].data.block;
+        }
+    }
+    UNREACHABLE_MSG("Control flow node without a header block");
+}
+
+size_t FindEndIf(const IR::AbstractSyntaxList& syntax_list, size_t if_index) {
+    IR::Block* const merge{syntax_list[if_index].data.if_node.merge};
+    for (size_t index = if_index + 1; index < syntax_list.size(); ++index) {
+        const IR::AbstractSyntaxNode& node{syntax_list[index]};
+        if (node.type == NodeType::EndIf && node.data.end_if.merge == merge) {
+            return index;
+        }
+    }
+    UNREACHABLE_MSG("If node without a matching EndIf");
+}
+
+/// Whether removing the edge leaves its target with at least one predecessor.
+bool HasOtherPredecessor(const IR::Block* block, const IR::Block* pred) {
+    return std::ranges::any_of(block->ImmPredecessors(),
+                               [pred](const IR::Block* other) { return other != pred; });
+}
+
+class ControlFlowSimplifier {
+public:
+    explicit ControlFlowSimplifier(IR::Program& program_) : program{program_} {}
+
+    bool FoldConstantBranches() {
+        bool changed{false};
+        auto& syntax_list{program.syntax_list};
+        size_t index{0};
+        while (index < syntax_list.size()) {
+            // A fold removes the node, so the next one moves into its place.
+            const IR::AbstractSyntaxNode& node{syntax_list[index]};
+            bool folded{false};
+            if (node.type == NodeType::If) {
+                if (const auto cond{ConstantCondition(node.data.if_node.cond)}) {
+                    folded = *cond ? FoldTakenIf(index) : FoldSkippedIf(index);
+                }
+            } else if (node.type == NodeType::Break) {
+                const auto cond{ConstantCondition(node.data.break_node.cond)};
+                if (cond && !*cond) {
+                    folded = FoldSkippedBreak(index);
+                }
+            }
+            changed |= folded;
+            if (!folded) {
+                ++index;
+            }
+        }
+        return changed;
+    }
+
+    bool MergeBlocks() {
+        bool changed{false};
+        auto& syntax_list{program.syntax_list};
+        const std::unordered_set<const IR::Block*> structural{StructuralBlocks()};
+        size_t index{0};
+        while (index + 1 < syntax_list.size()) {
+            const IR::AbstractSyntaxNode& first{syntax_list[index]};
+            const IR::AbstractSyntaxNode& second{syntax_list[index + 1]};
+            if (first.type == NodeType::Block && second.type == NodeType::Block &&
+                !structural.contains(second.data.block) &&
+                Merge(first.data.block, second.data.block)) {
+                syntax_list.erase(syntax_list.begin() + index + 1);
+                changed = true;
+                continue;
+            }
+            ++index;
+        }
+        return changed;
+    }
+
+private:
+    /// The body always runs, drop the edge that skips it.
+    bool FoldTakenIf(size_t if_index) {
+        auto& syntax_list{program.syntax_list};
+        const auto if_node{syntax_list[if_index].data.if_node};
+        IR::Block* const header{HeaderBlock(syntax_list, if_index)};
+        if (!HasOtherPredecessor(if_node.merge, header)) {
+            return false;
+        }
+        header->RemoveBranch(if_node.merge);
+        ReleaseCondition(if_node.cond);
+
+        const size_t endif_index{FindEndIf(syntax_list, if_index)};
+        syntax_list.erase(syntax_list.begin() + endif_index);
+        syntax_list.erase(syntax_list.begin() + if_index);
+        return true;
+    }
+
+    /// The body never runs, remove it along with the edges leaving it.
+    bool FoldSkippedIf(size_t if_index) {
+        auto& syntax_list{program.syntax_list};
+        const auto if_node{syntax_list[if_index].data.if_node};
+        const size_t endif_index{FindEndIf(syntax_list, if_index)};
+
+        std::unordered_set<IR::Block*> region;
+        for (size_t index = if_index + 1; index < endif_index; ++index) {
+            if (syntax_list[index].type == NodeType::Block) {
+                region.insert(syntax_list[index].data.block);
+            }
+        }
+        // Branches out of the body, e.g. breaks, must not be the only way into their target.
+        for (IR::Block* const block : region) {
+            for (IR::Block* const succ : block->ImmSuccessors()) {
+                if (region.contains(succ) || succ == if_node.merge) {
+                    continue;
+                }
+                const bool reachable{std::ranges::any_of(
+                    succ->ImmPredecessors(),
+                    [&region](IR::Block* pred) { return !region.contains(pred); })};
+                if (!reachable) {
+                    return false;
+                }
+            }
+        }
+
+        IR::Block* const header{HeaderBlock(syntax_list, if_index)};
+        header->RemoveBranch(if_node.body);
+        ReleaseCondition(if_node.cond);
+        for (IR::Block* const block : region) {
+            const std::vector<IR::Block*> succs(block->ImmSuccessors().begin(),
+                                                block->ImmSuccessors().end());
+            for (IR::Block* const succ : succs) {
+                block->RemoveBranch(succ);
+            }
+        }
+        for (IR::Block* const block : region) {
+            for (IR::Inst& inst : block->Instructions()) {
+                inst.Invalidate();
+            }
+            block->Instructions().clear();
+        }
+        syntax_list.erase(syntax_list.begin() + if_index, syntax_list.begin() + endif_index + 1);
+        return true;
+    }
+
+    /// The break is never taken, fall through to the skip block.
+    bool FoldSkippedBreak(size_t break_index) {
+        auto& syntax_list{program.syntax_list};
+        const auto break_node{syntax_list[break_index].data.break_node};
+        IR::Block* const header{HeaderBlock(syntax_list, break_index)};
+        if (!HasOtherPredecessor(break_node.merge, header)) {
+            return false;
+        }
+        header->RemoveBranch(break_node.merge);
+        ReleaseCondition(break_node.cond);
+        syntax_list.erase(syntax_list.begin() + break_index);
+        return true;
+    }
+
+    /// Blocks named by control flow nodes, which must keep their identity.
+    std::unordered_set<const IR::Block*> StructuralBlocks() const {
+        std::unordered_set<const IR::Block*> blocks;
+        for (const IR::AbstractSyntaxNode& node : program.syntax_list) {
+            switch (node.type) {
+            case NodeType::If:
+                blocks.insert(node.data.if_node.body);
+                blocks.insert(node.data.if_node.merge);
+                break;
+            case NodeType::EndIf:
+                blocks.insert(node.data.end_if.merge);
+                break;
+            case NodeType::Loop:
+                blocks.insert(node.data.loop.body);
+                blocks.insert(node.data.loop.continue_block);
+                blocks.insert(node.data.loop.merge);
+                break;
+            case NodeType::Repeat:
+                blocks.insert(node.data.repeat.loop_header);
+                blocks.insert(node.data.repeat.merge);
+                break;
+            case NodeType::Break:
+                blocks.insert(node.data.break_node.merge);
+                blocks.insert(node.data.break_node.skip);
+                break;
+            default:
+                break;
+            }
+        }
+        return blocks;
+    }
+
+    /// Appends next to block when it is its only successor and block its only predecessor.
+    bool Merge(IR::Block* block, IR::Block* next) {
+        if (block->ImmSuccessors().size() != 1 || block->ImmSuccessors()[0] != next ||
+            next->ImmPredecessors().size() != 1) {
+            return false;
+        }
+        for (IR::Inst& inst : next->Instructions()) {
+            if (inst.GetOpcode() == IR::Opcode::Phi) {
+                if (inst.NumArgs() != 1) {
+                    return false;
+                }
+                inst.ReplaceUsesWithAndRemove(inst.Arg(0));
+            }
+        }
+
+        // Successors of next now branch from block.
+        const std::vector<IR::Block*> succs(next->ImmSuccessors().begin(),
+                                            next->ImmSuccessors().end());
+        for (IR::Block* const succ : succs) {
+            for (IR::Inst& inst : succ->Instructions()) {
+                if (inst.GetOpcode() != IR::Opcode::Phi) {
+                    continue;
+                }
+                for (size_t i = 0; i < inst.NumArgs(); ++i) {
+                    if (inst.PhiBlock(i) == next) {
+                        const IR::Value value{inst.Arg(i)};
+                        inst.ErasePhiOperand(next);
+                        inst.AddPhiOperand(block, value);
+                        break;
+                    }
+                }
+            }
+            next->RemoveBranch(succ);
+            block->AddBranch(succ);
+        }
+        block->RemoveBranch(next);
+
+        for (IR::Inst& inst : next->Instructions()) {
+            inst.SetParent(block);
+        }
+        block->Instructions().splice(block->end(), next->Instructions());
+        return true;
+    }
+
+    IR::Program& program;
+};
+
+} // Anonymous namespace
+
+void ControlFlowSimplificationPass(IR::Program& program) {
+    ControlFlowSimplifier simplifier{program};
+    bool changed{simplifier.FoldConstantBranches()};
+    changed |= simplifier.MergeBlocks();
+    if (!changed) {
+        return;
+    }
+
+    program.blocks.clear();
+    for (const IR::AbstractSyntaxNode& node : program.syntax_list) {
+        if (node.type == NodeType::Block) {
+            program.blocks.push_back(node.data.block);
+        }
+    }
+    program.post_order_blocks = IR::PostOrder(program.syntax_list.front());
+}
+
+} // namespace Shader::Optimization
@@ -1,20 +1,130 @@
 // SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 #include "shader_recompiler/ir/program.h"
 
 namespace Shader::Optimization {
 
+/// Number of bytes written by a shared memory store, or zero for other instructions.
+static u32 SharedStoreSize(IR::Opcode op) {
+    switch (op) {
+    case IR::Opcode::WriteSharedU16:
+        return 2;
+    case IR::Opcode::WriteSharedU32:
+        return 4;
+    case IR::Opcode::WriteSharedU64:
+        return 8;
+    default:
+        return 0;
+    }
+}
+
+static bool MayObserveShared(const IR::Inst& inst) {
+    switch (inst.GetOpcode()) {
+    case IR::Opcode::LoadSharedU16:
+    case IR::Opcode::LoadSharedU32:
+    case IR::Opcode::LoadSharedU64:
+    case IR::Opcode::Barrier:
+    case IR::Opcode::WorkgroupMemoryBarrier:
+    case IR::Opcode::DeviceMemoryBarrier:
+        return true;
+    default:
+        // Atomics read the location and anything else with side effects may hand control
+        // to another invocation.
+        return inst.MayHaveSideEffects() && SharedStoreSize(inst.GetOpcode()) == 0;
+    }
+}
+
+/// Removes shared memory stores that are overwritten within the same block before anything
+/// could have read them.
+static void SharedDeadStoreElimination(IR::Program& program) {
+    std::unordered_map<IR::Value, IR::Inst*> pending;
+    for (IR::Block* const block : program.blocks) {
+        pending.clear();
+        for (IR::Inst& inst : block->Instructions()) {
+            const u32 size = SharedStoreSize(inst.GetOpcode());
+            if (size != 0) {
+                const IR::Value address = inst.Arg(0).Resolve();
+                const auto [it, inserted] = pending.try_emplace(address, &inst);
+                if (!inserted) {
+                    // Only a store of at least the same width fully covers the previous one.
+                    if (SharedStoreSize(it->second->GetOpcode()) <= size) {
+                        it->second->Invalidate();
+                    }
+                    it->second = &inst;
+                }
+            } else if (MayObserveShared(inst)) {
+                pending.clear();
+            }
+        }
+    }
+}
+
 void DeadCodeEliminationPass(IR::Program& program) {
-    // We iterate over the instructions in reverse order.
-    // This is because removing an instruction reduces the number of uses for earlier instructions.
-    for (IR::Block* const block : program.post_order_blocks) {
-        auto it{block->end()};
-        while (it != block->begin()) {
-            --it;
-            if (!it->HasUses() && !it->MayHaveSideEffects()) {
-                it->Invalidate();
-                it = block->Instructions().erase(it);
+    SharedDeadStoreElimination(program);
+
+    // Mark everything that side effects and control flow depend on, then sweep the rest. Unlike
+    // removing unused instructions this also catches cycles of phis that only feed each other.
+    std::unordered_set<IR::Inst*> live;
+    std::vector<IR::Inst*> worklist;
+    const auto mark = [&](const IR::Value& value) {
+        if (value.IsImmediate() && !value.IsIdentity()) {
+            return;
+        }
+        if (IR::Inst* const inst = value.Inst(); live.insert(inst).second) {
+            worklist.push_back(inst);
+        }
+    };
+    for (IR::Block* const block : program.blocks) {
+        for (IR::Inst& inst : block->Instructions()) {
+            if (inst.MayHaveSideEffects()) {
+                mark(IR::Value{&inst});
+            }
+        }
+    }
+    for (const IR::AbstractSyntaxNode& node : program.syntax_list) {
+        switch (node.type) {
+        case IR::AbstractSyntaxNode::Type::If:
+            mark(node.data.if_node.cond);
+            break;
+        case IR::AbstractSyntaxNode::Type::Repeat:
+            mark(node.data.repeat.cond);
+            break;
+        case IR::AbstractSyntaxNode::Type::Break:
+            mark(node.data.break_node.cond);
+            break;
+        default:
+            break;
+        }
+    }
+    while (!worklist.empty()) {
+        IR::Inst* const inst = worklist.back();
+        worklist.pop_back();
+        const size_t num_args = inst->NumArgs();
+        for (size_t i = 0; i < num_args; ++i) {
+            mark(inst->Arg(i));
+        }
+    }
+
+    // Clear the arguments of every dead instruction before unlinking any of them, so uses
+    // between dead instructions are gone by the time they are erased.
+    for (IR::Block* const block : program.blocks) {
+        for (IR::Inst& inst : block->Instructions()) {
+            if (!live.contains(&inst)) {
+                inst.Invalidate();
+            }
+        }
+    }
+    for (IR::Block* const block : program.blocks) {
+        auto& instructions = block->Instructions();
+        for (auto it = instructions.begin(); it != instructions.end();) {
+            if (live.contains(&*it)) {
+                ++it;
+            } else {
+                it = instructions.erase(it);
             }
         }
     }
@@ -0,0 +1,259 @@
+// SPDX-FileCopyrightText: Copyright 2025 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <boost/container/small_vector.hpp>
+#include "common/hash.h"
+#include "shader_recompiler/ir/program.h"
+
+namespace Shader::Optimization {
+
+// Dominator based global value numbering. Walks the dominator tree in preorder with a scoped
+// table of the pure expressions available at each block, and replaces any instruction that
+// recomputes one of them with the dominating definition.
+
+namespace {
+
+struct Expression {
+    IR::Opcode op;
+    u32 flags;
+    boost::container::small_vector<IR::Value, 4> args;
+
+    bool operator==(const Expression&) const = default;
+};
+
+struct HashExpression {
+    size_t operator()(const Expression& expr) const {
+        u64 h = HashCombine(static_cast<u64>(expr.op), static_cast<u64>(expr.flags));
+        for (const IR::Value& arg : expr.args) {
+            h = HashCombine(static_cast<u64>(std::hash<IR::Value>{}(arg)), h);
+        }
+        return h;
+    }
+};
+
+bool IsCommutative(IR::Opcode op) {
+    switch (op) {
+    case IR::Opcode::FPAdd32:
+    case IR::Opcode::FPAdd64:
+    case IR::Opcode::FPMul32:
+    case IR::Opcode::FPMul64:
+    case IR::Opcode::IAdd32:
+    case IR::Opcode::IAdd64:
+    case IR::Opcode::IMul32:
+    case IR::Opcode::IMul64:
+    case IR::Opcode::BitwiseAnd32:
+    case IR::Opcode::BitwiseAnd64:
+    case IR::Opcode::BitwiseOr32:
+    case IR::Opcode::BitwiseOr64:
+    case IR::Opcode::BitwiseXor32:
+    case IR::Opcode::SMin32:
+    case IR::Opcode::UMin32:
+    case IR::Opcode::SMax32:
+    case IR::Opcode::UMax32:
+    case IR::Opcode::IEqual32:
+    case IR::Opcode::IEqual64:
+    case IR::Opcode::INotEqual32:
+    case IR::Opcode::INotEqual64:
+    case IR::Opcode::LogicalOr:
+    case IR::Opcode::LogicalAnd:
+    case IR::Opcode::LogicalXor:
+        return true;
+    default:
+        return false;
+    }
+}
+
+/// Whether two instances of the instruction with equal operands always produce the same value.
+bool IsValueNumbered(const IR::Inst& inst) {
+    if (inst.MayHaveSideEffects()) {
+        return false;
+    }
+    switch (inst.GetOpcode()) {
+    // SSA plumbing and values that are not computed.
+    case IR::Opcode::Phi:
+    case IR::Opcode::Identity:
+    case IR::Opcode::Void:
+    case IR::Opcode::UndefU1:
+    case IR::Opcode::UndefU8:
+    case IR::Opcode::UndefU16:
+    case IR::Opcode::UndefU32:
+    case IR::Opcode::UndefU64:
+    // Register accesses, gone after SSA rewrite.
+    case IR::Opcode::GetThreadBitScalarReg:
+    case IR::Opcode::GetScalarRegister:
+    case IR::Opcode::GetVectorRegister:
+    case IR::Opcode::GetGotoVariable:
+    case IR::Opcode::GetScc:
+    case IR::Opcode::GetExec:
+    case IR::Opcode::GetVcc:
+    case IR::Opcode::GetVccLo:
+    case IR::Opcode::GetVccHi:
+    case IR::Opcode::GetM0:
+    // Reads of memory the shader itself may write.
+    case IR::Opcode::LoadSharedU16:
+    case IR::Opcode::LoadSharedU32:
+    case IR::Opcode::LoadSharedU64:
+    case IR::Opcode::LoadBufferU8:
+    case IR::Opcode::LoadBufferU16:
+    case IR::Opcode::LoadBufferU32:
+    case IR::Opcode::LoadBufferU32x2:
+    case IR::Opcode::LoadBufferU32x3:
+    case IR::Opcode::LoadBufferU32x4:
+    case IR::Opcode::LoadBufferU64:
+    case IR::Opcode::LoadBufferF32:
+    case IR::Opcode::LoadBufferF32x2:
+    case IR::Opcode::LoadBufferF32x3:
+    case IR::Opcode::LoadBufferF32x4:
+    case IR::Opcode::LoadBufferFormatF32:
+    case IR::Opcode::GetPatch:
+    case IR::Opcode::GetTessGenericAttribute:
+    case IR::Opcode::ReadTcsGenericOuputAttribute:
+    // Image reads and implicit derivatives depend on memory and on the active lanes.
+    case IR::Opcode::ImageSampleRaw:
+    case IR::Opcode::ImageSampleImplicitLod:
+    case IR::Opcode::ImageSampleExplicitLod:
+    case IR::Opcode::ImageSampleDrefImplicitLod:
+    case IR::Opcode::ImageSampleDrefExplicitLod:
+    case IR::Opcode::ImageGather:
+    case IR::Opcode::ImageGatherDref:
+    case IR::Opcode::ImageQueryDimensions:
+    case IR::Opcode::ImageQueryLod:
+    case IR::Opcode::ImageGradient:
+    case IR::Opcode::ImageRead:
+    // Cross lane operations depend on the active lanes at the point they execute.
+    case IR::Opcode::QuadShuffle:
+    case IR::Opcode::ReadFirstLane:
+    case IR::Opcode::ReadLane:
+    case IR::Opcode::WriteLane:
+        return false;
+    default:
+        return inst.Type() != IR::Type::Void;
+    }
+}
+
+Expression MakeExpression(const IR::Inst& inst) {
+    Expression expr{
+        .op = inst.GetOpcode(),
+        .flags = inst.Flags<u32>(),
+    };
+    const size_t num_args = inst.NumArgs();
+    for (size_t i = 0; i < num_args; ++i) {
+        expr.args.push_back(inst.Arg(i).Resolve());
+    }
+    if (IsCommutative(expr.op)) {
+        // Put instructions before immediates and order instructions by address, so both operand
+        // orders map to the same expression.
+        IR::Value& a = expr.args[0];
+        IR::Value& b = expr.args[1];
+        if (a.IsImmediate() && !b.IsImmediate()) {
+            std::swap(a, b);
+        } else if (!a.IsImmediate() && !b.IsImmediate() && b.Inst() < a.Inst()) {
+            std::swap(a, b);
+        }
+    }
+    return expr;
+}
+
+/// Immediate dominators of the reachable blocks, as indices into the reverse post order.
+std::vector<u32> ComputeImmediateDominators(const IR::BlockList& rpo,
+                                            const std::unordered_map<IR::Block*, u32>& order) {
+    constexpr u32 Undefined = ~0U;
+    std::vector<u32> idom(rpo.size(), Undefined);
+    idom[0] = 0;
+
+    const auto intersect = [&](u32 a, u32 b) {
+        while (a != b) {
+            while (a > b) {
+                a = idom[a];
+            }
+            while (b > a) {
+                b = idom[b];
+            }
+        }
+        return a;
+    };
+
+    // Cooper, Harvey and Kennedy, "A Simple, Fast Dominance Algorithm".
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (u32 i = 1; i < rpo.size(); ++i) {
+            u32 new_idom = Undefined;
+            for (IR::Block* const pred : rpo[i]->ImmPredecessors()) {
+                const auto it = order.find(pred);
+                if (it == order.end() || idom[it->second] == Undefined) {
+                    continue;
+                }
+                new_idom = new_idom == Undefined ? it->second : intersect(it->second, new_idom);
+            }
+            if (new_idom != Undefined && idom[i] != new_idom) {
+                idom[i] = new_idom;
+                changed = true;
+            }
+        }
+    }
+    return idom;
+}
+
+} // Anonymous namespace
+
+void GlobalValueNumberingPass(IR::Program& program) {
+    if (program.post_order_blocks.empty()) {
+        return;
+    }
+    const IR::BlockList rpo(program.post_order_blocks.rbegin(), program.post_order_blocks.rend());
+    std::unordered_map<IR::Block*, u32> order;
+    order.reserve(rpo.size());
+    for (u32 i = 0; i < rpo.size(); ++i) {
+        order.emplace(rpo[i], i);
+    }
+
+    const std::vector<u32> idom = ComputeImmediateDominators(rpo, order);
+    std::vector<std::vector<u32>> children(rpo.size());
+    for (u32 i = 1; i < rpo.size(); ++i) {
+        children[idom[i]].push_back(i);
+    }
+
+    std::unordered_map<Expression, IR::Inst*, HashExpression> available;
+    std::vector<const Expression*> scope_log;
+
+    // Each stack entry is a block to enter, or the scope size to unwind to when leaving one.
+    struct Visit {
+        u32 block;
+        size_t scope_size;
+        bool leave;
+    };
+    std::vector<Visit> stack{{.block = 0, .scope_size = 0, .leave = false}};
+    while (!stack.empty()) {
+        const Visit visit = stack.back();
+        stack.pop_back();
+        if (visit.leave) {
+            while (scope_log.size() > visit.scope_size) {
+                available.erase(*scope_log.back());
+                scope_log.pop_back();
+            }
+            continue;
+        }
+
+        stack.push_back({.block = visit.block, .scope_size = scope_log.size(), .leave = true});
+        for (IR::Inst& inst : rpo[visit.block]->Instructions()) {
+            if (!IsValueNumbered(inst)) {
+                continue;
+            }
+            const auto [it, inserted] = available.try_emplace(MakeExpression(inst), &inst);
+            if (inserted) {
+                scope_log.push_back(&it->first);
+            } else {
+                inst.ReplaceUsesWithAndRemove(IR::Value{it->second});
+            }
+        }
+        for (const u32 child : children[visit.block]) {
+            stack.push_back({.block = child, .scope_size = 0, .leave = false});
+        }
+    }
+}
+
+} // namespace Shader::Optimization
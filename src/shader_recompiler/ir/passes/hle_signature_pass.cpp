@@ -0,0 +1,330 @@
+// SPDX-FileCopyrightText: Copyright 2025 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <bit>
+#include <optional>
+#include "shader_recompiler/info.h"
+#include "shader_recompiler/ir/program.h"
+
+namespace Shader::Optimization {
+
+// Recognizes compute kernels that only fill or copy a buffer, so the renderer can replace the
+// dispatch with a transfer command. The match is structural: a single straight-line block whose
+// only side effect is one buffer store, at a byte offset that is an affine function of the
+// invocation ids, of a value that is either constant for the dispatch or loaded from another
+// buffer at an affine offset. Whether the dispatch actually covers a contiguous range is checked
+// when it is executed.
+
+namespace {
+
+using Access = HleSignature::Access;
+
+/// Limits the recursion through address arithmetic, real kernels need a handful of levels.
+constexpr u32 MaxAddressDepth = 16;
+
+/// Coefficients beyond this could not describe an offset into a buffer.
+constexpr s64 MaxStride = s64{1} << 32;
+
+bool IsInRange(const Access& access) {
+    const auto in_range = [](s64 value) { return value > -MaxStride && value < MaxStride; };
+    return std::ranges::all_of(access.local_stride, in_range) &&
+           std::ranges::all_of(access.group_stride, in_range) && in_range(access.offset);
+}
+
+/// Whether the form is exactly one invocation id, which is what the 24-bit multiplies extract.
+bool IsSingleId(const Access& access) {
+    s64 total{};
+    for (u32 i = 0; i < 3; ++i) {
+        if (access.local_stride[i] < 0 || access.group_stride[i] < 0) {
+            return false;
+        }
+        total += access.local_stride[i] + access.group_stride[i];
+    }
+    return total == 1 && access.offset == 0;
+}
+
+Access Scale(Access access, s64 factor) {
+    for (u32 i = 0; i < 3; ++i) {
+        access.local_stride[i] *= factor;
+        access.group_stride[i] *= factor;
+    }
+    access.offset *= factor;
+    return access;
+}
+
+Access Combine(const Access& a, const Access& b, s64 sign) {
+    Access result{a};
+    for (u32 i = 0; i < 3; ++i) {
+        result.local_stride[i] += sign * b.local_stride[i];
+        result.group_stride[i] += sign * b.group_stride[i];
+    }
+    result.offset += sign * b.offset;
+    return result;
+}
+
+bool IsConstant(const Access& access) {
+    return std::ranges::all_of(access.local_stride, [](s64 v) { return v == 0; }) &&
+           std::ranges::all_of(access.group_stride, [](s64 v) { return v == 0; });
+}
+
+/// Byte offset computed by value as an affine function of the invocation ids. The IR computes
+/// modulo 2^32 and these are ring operations, so the result agrees with the shader whenever the
+/// exact value stays within the buffer. Immediates are sign extended, a displacement like
+/// 0xfffffffc is a subtraction and must not be mistaken for an offset near 4GiB.
+std::optional<Access> AnalyzeOffset(const IR::Value& value, u32 depth = 0) {
+    const IR::Value resolved{value.Resolve()};
+    if (resolved.IsImmediate()) {
+        return Access{.offset = static_cast<s32>(resolved.U32())};
+    }
+    if (depth == MaxAddressDepth) {
+        return std::nullopt;
+    }
+    const IR::Inst* const inst{resolved.InstRecursive()};
+    std::optional<Access> result;
+    switch (inst->GetOpcode()) {
+    case IR::Opcode::GetAttributeU32: {
+        const IR::Attribute attr{inst->Arg(0).Attribute()};
+        const IR::Value comp_value{inst->Arg(1).Resolve()};
+        if (!comp_value.IsImmediate() || comp_value.U32() >= 3) {
+            return std::nullopt;
+        }
+        const u32 comp{comp_value.U32()};
+        Access access{};
+        if (attr == IR::Attribute::LocalInvocationId) {
+            access.local_stride[comp] = 1;
+        } else if (attr == IR::Attribute::WorkgroupId) {
+            access.group_stride[comp] = 1;
+        } else {
+            return std::nullopt;
+        }
+        return access;
+    }
+    case IR::Opcode::IAdd32:
+    case IR::Opcode::ISub32: {
+        const auto a{AnalyzeOffset(inst->Arg(0), depth + 1)};
+        const auto b{AnalyzeOffset(inst->Arg(1), depth + 1)};
+        if (!a || !b) {
+            return std::nullopt;
+        }
+        result = Combine(*a, *b, inst->GetOpcode() == IR::Opcode::IAdd32 ? 1 : -1);
+        break;
+    }
+    case IR::Opcode::IMul32: {
+        const auto a{AnalyzeOffset(inst->Arg(0), depth + 1)};
+        const auto b{AnalyzeOffset(inst->Arg(1), depth + 1)};
+        if (!a || !b) {
+            return std::nullopt;
+        }
+        if (IsConstant(*b)) {
+            result = Scale(*a, b->offset);
+        } else if (IsConstant(*a)) {
+            result = Scale(*b, a->offset);
+        } else {
+            return std::nullopt;
+        }
+        break;
+    }
+    case IR::Opcode::ShiftLeftLogical32: {
+        const IR::Value shift{inst->Arg(1).Resolve()};
+        if (!shift.IsImmediate() || shift.U32() >= 32) {
+            return std::nullopt;
+        }
+        const auto a{AnalyzeOffset(inst->Arg(0), depth + 1)};
+        if (!a) {
+            return std::nullopt;
+        }
+        result = Scale(*a, s64{1} << shift.U32());
+        break;
+    }
+    case IR::Opcode::BitFieldUExtract:
+    case IR::Opcode::BitFieldSExtract: {
+        // The 24-bit multiplies extract the low bits of the ids, which only differs from the id
+        // itself for dispatches far larger than the renderer accepts.
+        const IR::Value offset{inst->Arg(1).Resolve()};
+        const IR::Value count{inst->Arg(2).Resolve()};
+        if (!offset.IsImmediate() || !count.IsImmediate() || offset.U32() != 0 ||
+            count.U32() != 24) {
+            return std::nullopt;
+        }
+        const auto a{AnalyzeOffset(inst->Arg(0), depth + 1)};
+        if (!a || !IsSingleId(*a)) {
+            return std::nullopt;
+        }
+        return a;
+    }
+    default:
+        return std::nullopt;
+    }
+    if (!result || !IsInRange(*result)) {
+        return std::nullopt;
+    }
+    return result;
+}
+
+/// Number of 32-bit components stored or loaded by a plain buffer access, zero otherwise.
+u32 NumDwords(IR::Opcode op) {
+    switch (op) {
+    case IR::Opcode::LoadBufferU32:
+    case IR::Opcode::LoadBufferF32:
+    case IR::Opcode::StoreBufferU32:
+    case IR::Opcode::StoreBufferF32:
+        return 1;
+    case IR::Opcode::LoadBufferU32x2:
+    case IR::Opcode::LoadBufferF32x2:
+    case IR::Opcode::StoreBufferU32x2:
+    case IR::Opcode::StoreBufferF32x2:
+        return 2;
+    case IR::Opcode::LoadBufferU32x3:
+    case IR::Opcode::LoadBufferF32x3:
+    case IR::Opcode::StoreBufferU32x3:
+    case IR::Opcode::StoreBufferF32x3:
+        return 3;
+    case IR::Opcode::LoadBufferU32x4:
+    case IR::Opcode::LoadBufferF32x4:
+    case IR::Opcode::StoreBufferU32x4:
+    case IR::Opcode::StoreBufferF32x4:
+        return 4;
+    default:
+        return 0;
+    }
+}
+
+bool IsCompositeConstruct(IR::Opcode op) {
+    switch (op) {
+    case IR::Opcode::CompositeConstructU32x2:
+    case IR::Opcode::CompositeConstructU32x3:
+    case IR::Opcode::CompositeConstructU32x4:
+    case IR::Opcode::CompositeConstructF32x2:
+    case IR::Opcode::CompositeConstructF32x3:
+    case IR::Opcode::CompositeConstructF32x4:
+        return true;
+    default:
+        return false;
+    }
+}
+
+/// Resolves the dword written by every invocation to a constant or a user data register.
+bool AnalyzeFillValue(const IR::Value& value, HleSignature& hle) {
+    const IR::Value resolved{value.Resolve()};
+    if (resolved.IsImmediate()) {
+        if (resolved.Type() == IR::Type::F32) {
+            hle.fill_value = std::bit_cast<u32>(resolved.F32());
+            return true;
+        }
+        if (resolved.Type() == IR::Type::U32) {
+            hle.fill_value = resolved.U32();
+            return true;
+        }
+        return false;
+    }
+    const IR::Inst* const inst{resolved.InstRecursive()};
+    switch (inst->GetOpcode()) {
+    case IR::Opcode::GetUserData:
+        hle.fill_reg = inst->Arg(0).ScalarReg();
+        return true;
+    case IR::Opcode::BitCastF32U32:
+    case IR::Opcode::BitCastU32F32:
+        return AnalyzeFillValue(inst->Arg(0), hle);
+    default:
+        return false;
+    }
+}
+
+/// Fills in the buffer and offset of a plain buffer load or store.
+bool AnalyzeAccess(const IR::Inst& inst, const Info& info, Access& access) {
+    const IR::Value binding{inst.Arg(0).Resolve()};
+    if (!binding.IsImmediate() || binding.U32() >= info.buffers.size()) {
+        return false;
+    }
+    const BufferResource& buffer{info.buffers[binding.U32()]};
+    if (buffer.IsSpecial() || buffer.is_formatted) {
+        return false;
+    }
+    const auto offset{AnalyzeOffset(inst.Arg(1))};
+    if (!offset) {
+        return false;
+    }
+    access = *offset;
+    access.buffer = binding.U32();
+    access.sharp_stride = buffer.GetSharp(info).stride;
+    return true;
+}
+
+std::optional<HleSignature> Match(const IR::Program& program) {
+    for (const IR::AbstractSyntaxNode& node : program.syntax_list) {
+        if (node.type != IR::AbstractSyntaxNode::Type::Block &&
+            node.type != IR::AbstractSyntaxNode::Type::Return) {
+            return std::nullopt;
+        }
+    }
+    const IR::Inst* store{};
+    for (const IR::Block* const block : program.blocks) {
+        for (const IR::Inst& inst : block->Instructions()) {
+            const IR::Opcode op{inst.GetOpcode()};
+            if (op == IR::Opcode::Prologue || op == IR::Opcode::Epilogue ||
+                !inst.MayHaveSideEffects()) {
+                continue;
+            }
+            if (store || NumDwords(op) == 0) {
+                return std::nullopt;
+            }
+            store = &inst;
+        }
+    }
+    if (!store) {
+        return std::nullopt;
+    }
+
+    HleSignature hle{};
+    const u32 num_dwords{NumDwords(store->GetOpcode())};
+    hle.element_size = num_dwords * sizeof(u32);
+    if (!AnalyzeAccess(*store, program.info, hle.dst)) {
+        return std::nullopt;
+    }
+
+    const IR::Value value{store->Arg(2).Resolve()};
+    const IR::Inst* const producer{value.IsImmediate() ? nullptr : value.InstRecursive()};
+    if (producer && NumDwords(producer->GetOpcode()) == num_dwords) {
+        hle.type = HleSignature::Type::CopyBuffer;
+        if (!AnalyzeAccess(*producer, program.info, hle.src)) {
+            return std::nullopt;
+        }
+        return hle;
+    }
+
+    // Every component of the stored vector has to be the same dword.
+    IR::Value dword{value};
+    if (num_dwords > 1) {
+        if (!producer || !IsCompositeConstruct(producer->GetOpcode()) ||
+            producer->NumArgs() != num_dwords) {
+            return std::nullopt;
+        }
+        dword = producer->Arg(0).Resolve();
+        for (size_t i = 1; i < num_dwords; ++i) {
+            if (producer->Arg(i).Resolve() != dword) {
+                return std::nullopt;
+            }
+        }
+    }
+    hle.type = HleSignature::Type::FillBuffer;
+    if (!AnalyzeFillValue(dword, hle)) {
+        return std::nullopt;
+    }
+    return hle;
+}
+
+} // Anonymous namespace
+
+void HleSignaturePass(IR::Program& program) {
+    Info& info{program.info};
+    info.hle = {};
+    if (info.l_stage != LogicalStage::Compute) {
+        return;
+    }
+    if (const auto hle{Match(program)}) {
+        info.hle = *hle;
+    }
+}
+
+} // namespace Shader::Optimization
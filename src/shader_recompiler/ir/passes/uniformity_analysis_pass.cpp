@@ -0,0 +1,296 @@
+// SPDX-FileCopyrightText: Copyright 2025 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <optional>
+#include <ranges>
+#include <unordered_set>
+#include <vector>
+#include "shader_recompiler/ir/program.h"
+
+namespace Shader::Optimization {
+
+// Finds the values that are the same across all active invocations of a subgroup, which is what
+// GCN keeps in SGPRs. Everything starts out uniform and divergence is propagated from the
+// sources of per-lane values until it settles: through data dependencies, through phis at joins
+// of divergent branches and out of loops that lanes leave in different iterations.
+//
+// Subgroup broadcasts of uniform values are removed, and uniform branch conditions and memory
+// addresses are recorded so the backend can tell the driver they stay scalar.
+
+namespace {
+
+using NodeType = IR::AbstractSyntaxNode::Type;
+using InstSet = std::unordered_set<const IR::Inst*>;
+
+struct ControlDivergence {
+    /// Blocks where lanes coming from different paths meet again.
+    std::unordered_set<const IR::Block*> joins;
+    /// Bodies of loops that lanes may exit in different iterations.
+    std::vector<std::unordered_set<const IR::Block*>> divergent_loops;
+};
+
+bool IsDivergent(const InstSet& divergent, const IR::Value& value) {
+    const IR::Value resolved{value.Resolve()};
+    return !resolved.IsImmediate() && divergent.contains(resolved.Inst());
+}
+
+ControlDivergence AnalyzeControl(const IR::Program& program, const InstSet& divergent) {
+    struct Frame {
+        NodeType type;
+        bool divergent;
+        const IR::Block* key;
+        std::unordered_set<const IR::Block*> blocks;
+    };
+    ControlDivergence result;
+    std::vector<Frame> frames;
+    const IR::Block* last_block{};
+
+    const auto inner_loop = [&frames]() -> Frame* {
+        for (Frame& frame : frames | std::views::reverse) {
+            if (frame.type == NodeType::Loop) {
+                return &frame;
+            }
+        }
+        return nullptr;
+    };
+    const auto in_divergent_if = [&frames]() {
+        for (const Frame& frame : frames | std::views::reverse) {
+            if (frame.type == NodeType::Loop) {
+                return false;
+            }
+            if (frame.divergent) {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    for (const IR::AbstractSyntaxNode& node : program.syntax_list) {
+        switch (node.type) {
+        case NodeType::Block:
+            last_block = node.data.block;
+            for (Frame& frame : frames) {
+                if (frame.type == NodeType::Loop) {
+                    frame.blocks.insert(node.data.block);
+                }
+            }
+            break;
+        case NodeType::If: {
+            const bool is_divergent{IsDivergent(divergent, node.data.if_node.cond)};
+            if (is_divergent) {
+                result.joins.insert(node.data.if_node.merge);
+            }
+            frames.push_back({NodeType::If, is_divergent, node.data.if_node.merge, {}});
+            break;
+        }
+        case NodeType::EndIf:
+            if (!frames.empty() && frames.back().type == NodeType::If &&
+                frames.back().key == node.data.end_if.merge) {
+                frames.pop_back();
+            }
+            break;
+        case NodeType::Loop:
+            // The header block node comes right before the loop node.
+            frames.push_back({NodeType::Loop, false, node.data.loop.merge, {last_block}});
+            break;
+        case NodeType::Break:
+            if (IsDivergent(divergent, node.data.break_node.cond) || in_divergent_if()) {
+                result.joins.insert(node.data.break_node.merge);
+                if (Frame* const loop = inner_loop()) {
+                    loop->divergent = true;
+                }
+            }
+            break;
+        case NodeType::Repeat:
+            if (!frames.empty() && frames.back().type == NodeType::Loop &&
+                frames.back().key == node.data.repeat.merge) {
+                Frame loop{std::move(frames.back())};
+                frames.pop_back();
+                if (IsDivergent(divergent, node.data.repeat.cond)) {
+                    loop.divergent = true;
+                }
+                if (loop.divergent) {
+                    result.joins.insert(node.data.repeat.merge);
+                    result.divergent_loops.push_back(std::move(loop.blocks));
+                }
+            }
+            break;
+        default:
+            break;
+        }
+    }
+    return result;
+}
+
+bool IsDivergentSource(const IR::Inst& inst) {
+    switch (inst.GetOpcode()) {
+    case IR::Opcode::LaneId:
+    case IR::Opcode::QuadShuffle:
+    case IR::Opcode::WriteLane:
+    case IR::Opcode::UndefU1:
+    case IR::Opcode::UndefU8:
+    case IR::Opcode::UndefU16:
+    case IR::Opcode::UndefU32:
+    case IR::Opcode::UndefU64:
+    case IR::Opcode::GetPatch:
+    case IR::Opcode::GetTessGenericAttribute:
+    case IR::Opcode::ReadTcsGenericOuputAttribute:
+    case IR::Opcode::DataAppend:
+    case IR::Opcode::DataConsume:
+        return true;
+    case IR::Opcode::GetAttribute:
+    case IR::Opcode::GetAttributeU32: {
+        const IR::Attribute attr{inst.Arg(0).Attribute()};
+        return attr != IR::Attribute::WorkgroupId && attr != IR::Attribute::WorkgroupIndex;
+    }
+    default:
+        // Atomics return a different value to every lane.
+        return inst.MayHaveSideEffects() && inst.Type() != IR::Type::Void;
+    }
+}
+
+bool EscapesDivergentLoop(const IR::Inst& inst, const ControlDivergence& control) {
+    for (const auto& loop : control.divergent_loops) {
+        if (!loop.contains(inst.GetParent())) {
+            continue;
+        }
+        for (const IR::Use& use : inst.Uses()) {
+            if (!loop.contains(use.user->GetParent())) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool ComputeDivergence(const IR::Inst& inst, const InstSet& divergent,
+                       const ControlDivergence& control) {
+    switch (inst.GetOpcode()) {
+    case IR::Opcode::ReadFirstLane:
+    case IR::Opcode::GetUserData:
+    case IR::Opcode::WarpId:
+        return false;
+    case IR::Opcode::ReadLane:
+        return IsDivergent(divergent, inst.Arg(1));
+    case IR::Opcode::ConditionRef:
+        break;
+    case IR::Opcode::Phi:
+        if (control.joins.contains(inst.GetParent())) {
+            return true;
+        }
+        break;
+    default:
+        if (IsDivergentSource(inst)) {
+            return true;
+        }
+        break;
+    }
+    for (size_t i = 0; i < inst.NumArgs(); ++i) {
+        if (IsDivergent(divergent, inst.Arg(i))) {
+            return true;
+        }
+    }
+    return EscapesDivergentLoop(inst, control);
+}
+
+/// Operand holding the address of a memory access, if the instruction has one.
+std::optional<size_t> AddressOperand(IR::Opcode op) {
+    switch (op) {
+    case IR::Opcode::LoadSharedU16:
+    case IR::Opcode::LoadSharedU32:
+    case IR::Opcode::LoadSharedU64:
+    case IR::Opcode::WriteSharedU16:
+    case IR::Opcode::WriteSharedU32:
+    case IR::Opcode::WriteSharedU64:
+        return 0;
+    case IR::Opcode::ReadConstBuffer:
+    case IR::Opcode::LoadBufferU8:
+    case IR::Opcode::LoadBufferU16:
+    case IR::Opcode::LoadBufferU32:
+    case IR::Opcode::LoadBufferU32x2:
+    case IR::Opcode::LoadBufferU32x3:
+    case IR::Opcode::LoadBufferU32x4:
+    case IR::Opcode::LoadBufferU64:
+    case IR::Opcode::LoadBufferF32:
+    case IR::Opcode::LoadBufferF32x2:
+    case IR::Opcode::LoadBufferF32x3:
+    case IR::Opcode::LoadBufferF32x4:
+    case IR::Opcode::LoadBufferFormatF32:
+    case IR::Opcode::StoreBufferU8:
+    case IR::Opcode::StoreBufferU16:
+    case IR::Opcode::StoreBufferU32:
+    case IR::Opcode::StoreBufferU32x2:
+    case IR::Opcode::StoreBufferU32x3:
+    case IR::Opcode::StoreBufferU32x4:
+    case IR::Opcode::StoreBufferU64:
+    case IR::Opcode::StoreBufferF32:
+    case IR::Opcode::StoreBufferF32x2:
+    case IR::Opcode::StoreBufferF32x3:
+    case IR::Opcode::StoreBufferF32x4:
+    case IR::Opcode::StoreBufferFormatF32:
+        return 1;
+    default:
+        return std::nullopt;
+    }
+}
+
+} // Anonymous namespace
+
+void UniformityAnalysisPass(IR::Program& program) {
+    const IR::BlockList rpo(program.post_order_blocks.rbegin(), program.post_order_blocks.rend());
+    InstSet divergent;
+    bool changed{true};
+    while (changed) {
+        changed = false;
+        const ControlDivergence control{AnalyzeControl(program, divergent)};
+        for (const IR::Block* const block : rpo) {
+            for (const IR::Inst& inst : block->Instructions()) {
+                if (!divergent.contains(&inst) && ComputeDivergence(inst, divergent, control)) {
+                    divergent.insert(&inst);
+                    changed = true;
+                }
+            }
+        }
+    }
+
+    // Broadcasting a value that is already uniform is a no-op.
+    for (IR::Block* const block : rpo) {
+        for (IR::Inst& inst : block->Instructions()) {
+            const IR::Opcode op{inst.GetOpcode()};
+            if ((op == IR::Opcode::ReadFirstLane || op == IR::Opcode::ReadLane) &&
+                !IsDivergent(divergent, inst.Arg(0))) {
+                inst.ReplaceUsesWithAndRemove(inst.Arg(0));
+            }
+        }
+    }
+
+    const auto add_hint = [&](const IR::Value& value) {
+        IR::Value resolved{value.Resolve()};
+        if (!resolved.IsImmediate() &&
+            resolved.Inst()->GetOpcode() == IR::Opcode::ConditionRef) {
+            resolved = resolved.Inst()->Arg(0).Resolve();
+        }
+        if (!resolved.IsImmediate() && !divergent.contains(resolved.Inst())) {
+            program.uniform_values.insert(resolved.Inst());
+        }
+    };
+    program.uniform_values.clear();
+    for (const IR::AbstractSyntaxNode& node : program.syntax_list) {
+        if (node.type == NodeType::If) {
+            add_hint(node.data.if_node.cond);
+        } else if (node.type == NodeType::Break) {
+            add_hint(node.data.break_node.cond);
+        } else if (node.type == NodeType::Repeat) {
+            add_hint(node.data.repeat.cond);
+        }
+    }
+    for (const IR::Block* const block : rpo) {
+        for (const IR::Inst& inst : block->Instructions()) {
+            if (const auto operand{AddressOperand(inst.GetOpcode())}) {
+                add_hint(inst.Arg(*operand));
+            }
+        }
+    }
+}
+
+} // namespace Shader::Optimization
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <string>
+#include <unordered_set>
 #include "shader_recompiler/frontend/instruction.h"
 #include "shader_recompiler/info.h"
 #include "shader_recompiler/ir/abstract_syntax_list.h"
@@ -18,6 +19,8 @@ struct Program {
     BlockList blocks;
     BlockList post_order_blocks;
     std::vector<Gcn::GcnInst> ins_list;
+    /// Values known to be uniform across the subgroup that are worth telling the driver about.
+    std::unordered_set<const Inst*> uniform_values;
     Info& info;
 };
 
@@ -186,6 +186,8 @@ public:
     [[nodiscard]] Block* PhiBlock(size_t index) const;
     /// Add phi operand to a phi instruction.
     void AddPhiOperand(Block* predecessor, const Value& value);
+    /// Remove the phi operand coming from a predecessor, if there is one.
+    void ErasePhiOperand(Block* predecessor);
 
     void Invalidate();
     void ClearArgs();
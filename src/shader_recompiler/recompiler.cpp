@@ -82,8 +82,12 @@ IR::Program TranslateProgram(std::span<const u32> code, Pools& pools, Info& info
     Shader::Optimization::SharedMemoryToStoragePass(program, runtime_info, profile);
     Shader::Optimization::SharedMemoryBarrierPass(program, runtime_info, profile);
     Shader::Optimization::IdentityRemovalPass(program.blocks);
+    Shader::Optimization::GlobalValueNumberingPass(program);
+    Shader::Optimization::ControlFlowSimplificationPass(program);
     Shader::Optimization::DeadCodeEliminationPass(program);
     Shader::Optimization::ConstantPropagationPass(program.post_order_blocks);
+    Shader::Optimization::UniformityAnalysisPass(program);
+    Shader::Optimization::HleSignaturePass(program);
     Shader::Optimization::CollectShaderInfoPass(program);
 
     Shader::IR::DumpProgram(program, info);
@@ -66,6 +66,32 @@ static std::span<const u32> NextPacket(std::span<const u32> span, size_t offset)
     return span.subspan(offset);
 }
 
+/// Counts the run of back-to-back indirect draw packets starting at the head of the span that
+/// read tightly packed argument records. No state can change in between such packets, so the
+/// whole run can be issued as a single multi-draw without reading the arguments on the CPU. The
+/// packets must also write the fetched base vertex and start instance to the same registers.
+template <typename Packet>
+static u32 CountBatchableIndirectDraws(std::span<const u32> span, u32 stride, u32 max_draws) {
+    const auto* first = reinterpret_cast<const Packet*>(span.data());
+    const u32 packet_size = first->header.NumWords() + 1;
+    u32 num_draws = 1;
+    span = span.subspan(packet_size);
+    while (num_draws < max_draws && span.size() >= packet_size) {
+        const auto* next = reinterpret_cast<const Packet*>(span.data());
+        if (next->header.type != 3 || next->header.opcode != first->header.opcode ||
+            next->header.predicate != first->header.predicate ||
+            next->header.NumWords() + 1 != packet_size ||
+            next->draw_initiator != first->draw_initiator || next->dw2 != first->dw2 ||
+            next->dw3 != first->dw3 ||
+            next->data_offset != first->data_offset + num_draws * stride) {
+            break;
+        }
+        ++num_draws;
+        span = span.subspan(packet_size);
+    }
+    return num_draws;
+}
+
 Liverpool::Liverpool() {
     process_thread = std::jthread{std::bind_front(&Liverpool::Process, this)};
 }
@@ -489,15 +515,22 @@ Liverpool::Task Liverpool::ProcessGraphics(std::span<const u32> dcb, std::span<c
                 const auto* draw_indirect = reinterpret_cast<const PM4CmdDrawIndirect*>(header);
                 const auto offset = draw_indirect->data_offset;
                 const auto stride = sizeof(DrawIndirectArgs);
+                u32 num_draws = 1;
                 if (DebugState.DumpingCurrentReg()) {
                     DebugState.PushRegsDump(base_addr, reinterpret_cast<uintptr_t>(header), regs);
+                } else if (rasterizer) {
+                    num_draws = CountBatchableIndirectDraws<PM4CmdDrawIndirect>(
+                        dcb, stride, rasterizer->MaxIndirectDrawBatch());
                 }
                 if (rasterizer) {
                     const auto cmd_address = reinterpret_cast<const void*>(header);
                     rasterizer->ScopeMarkerBegin(fmt::format("gfx:{}:DrawIndirect", cmd_address));
-                    rasterizer->DrawIndirect(false, indirect_args_addr, offset, stride, 1, 0);
+                    rasterizer->DrawIndirect(false, indirect_args_addr, offset, stride, num_draws,
+                                             0);
                     rasterizer->ScopeMarkerEnd();
                 }
+                // Skip the packets that were folded into this draw
+                dcb = NextPacket(dcb, (header->type3.NumWords() + 1) * (num_draws - 1));
                 break;
             }
             case PM4ItOpcode::DrawIndexIndirect: {
@@ -505,16 +538,23 @@ Liverpool::Task Liverpool::ProcessGraphics(std::span<const u32> dcb, std::span<c
                     reinterpret_cast<const PM4CmdDrawIndexIndirect*>(header);
                 const auto offset = draw_index_indirect->data_offset;
                 const auto stride = sizeof(DrawIndexedIndirectArgs);
+                u32 num_draws = 1;
                 if (DebugState.DumpingCurrentReg()) {
                     DebugState.PushRegsDump(base_addr, reinterpret_cast<uintptr_t>(header), regs);
+                } else if (rasterizer) {
+                    num_draws = CountBatchableIndirectDraws<PM4CmdDrawIndexIndirect>(
+                        dcb, stride, rasterizer->MaxIndirectDrawBatch());
                 }
                 if (rasterizer) {
                     const auto cmd_address = reinterpret_cast<const void*>(header);
                     rasterizer->ScopeMarkerBegin(
                         fmt::format("gfx:{}:DrawIndexIndirect", cmd_address));
-                    rasterizer->DrawIndirect(true, indirect_args_addr, offset, stride, 1, 0);
+                    rasterizer->DrawIndirect(true, indirect_args_addr, offset, stride, num_draws,
+                                             0);
                     rasterizer->ScopeMarkerEnd();
                 }
+                // Skip the packets that were folded into this draw
+                dcb = NextPacket(dcb, (header->type3.NumWords() + 1) * (num_draws - 1));
                 break;
             }
             case PM4ItOpcode::DrawIndexIndirectMulti: {
@@ -657,9 +697,8 @@ Liverpool::Task Liverpool::ProcessGraphics(std::span<const u32> dcb, std::span<c
                 if (event_eos->command == PM4CmdEventWriteEos::Command::GdsStore) {
                     ASSERT(event_eos->size == 1);
                     if (rasterizer) {
-                        rasterizer->Finish();
-                        const u32 value = rasterizer->ReadDataFromGds(event_eos->gds_index);
-                        *event_eos->Address() = value;
+                        rasterizer->WriteGdsToMemory(event_eos->gds_index,
+                                                     event_eos->Address<VAddr>(), sizeof(u32));
                     }
                 }
                 break;
@@ -242,6 +242,8 @@ bool BufferCache::CommitPendingDownloads(bool wait_done) {
         });
     });
     pending_download_ranges.Clear();
+    RangeSet host_write_ranges = pending_host_write_ranges;
+    pending_host_write_ranges.Clear();
     if (total_size_bytes == 0) {
         return false;
     }
@@ -270,7 +272,8 @@ bool BufferCache::CommitPendingDownloads(bool wait_done) {
         Buffer& buffer = slot_buffers[buffer_id];
         cmdbuf.copyBuffer(buffer.Handle(), download_buffer.Handle(), buffer_copies);
     }
-    const auto writeback_host = [this, download, offset, copies = std::move(copies)]() {
+    const auto writeback_host = [this, download, offset, copies = std::move(copies),
+                                 host_write_ranges = std::move(host_write_ranges)]() {
         auto* memory = Core::Memory::Instance();
         for (auto it = copies.begin(); it != copies.end(); ++it) {
             auto& buffer_copies = it.value();
@@ -283,6 +286,13 @@ bool BufferCache::CommitPendingDownloads(bool wait_done) {
                                              download + dst_offset, copy.size)) {
                     //std::memcpy(std::bit_cast<u8*>(copy_device_addr), download + dst_offset,
                     //            copy.size);
+                    // Stores the guest waits on must land even outside of direct memory.
+                    host_write_ranges.ForEachInRange(
+                        copy_device_addr, copy.size, [&](VAddr range_addr, VAddr range_end) {
+                            const u64 range_offset = dst_offset + (range_addr - copy_device_addr);
+                            std::memcpy(std::bit_cast<u8*>(range_addr), download + range_offset,
+                                        range_end - range_addr);
+                        });
                 }
             }
         }
@@ -301,6 +311,17 @@ bool BufferCache::CommitPendingDownloads(bool wait_done) {
     return true;
 }
 
+void BufferCache::DownloadGdsData(u32 gds_offset, VAddr address, u32 num_bytes) {
+    // Copy into the cached buffer backing the destination, which marks the range GPU modified so
+    // that neither stale guest memory is uploaded over the result nor the copy is considered clean.
+    CopyBuffer(address, gds_offset, num_bytes, false, true);
+    // The range is now pending download, let the download thread write it back once the
+    // submission containing the copy completes instead of draining the GPU from here. Unlike
+    // other downloads the store is written even when the destination is not direct memory.
+    pending_host_write_ranges.Add(address, num_bytes);
+    CommitPendingDownloads(false);
+}
+
 void BufferCache::BindVertexBuffers(const Vulkan::GraphicsPipeline& pipeline) {
     Vulkan::VertexInputs<vk::VertexInputAttributeDescription2EXT> attributes;
     Vulkan::VertexInputs<vk::VertexInputBindingDescription2EXT> bindings;
@@ -829,6 +850,7 @@ void BufferCache::ProcessFaultBuffer() {
     cmdbuf.bindPipeline(vk::PipelineBindPoint::eCompute, *fault_process_pipeline);
     cmdbuf.pushDescriptorSetKHR(vk::PipelineBindPoint::eCompute, *fault_process_pipeline_layout, 0,
                                 writes);
+    scheduler.InvalidateBindings();
     constexpr u32 num_threads = CACHING_NUMPAGES / 32; // 1 bit per page, 32 pages per workgroup
     constexpr u32 num_workgroups = Common::DivCeil(num_threads, 64u);
     cmdbuf.dispatch(num_workgroups, 1, 1);
@@ -1249,7 +1271,10 @@ void BufferCache::WriteDataBuffer(Buffer& buffer, VAddr address, const void* val
 void BufferCache::DeleteBuffer(BufferId buffer_id) {
     Buffer& buffer = slot_buffers[buffer_id];
     Unregister(buffer_id);
-    scheduler.DeferOperation([this, buffer_id] { slot_buffers.erase(buffer_id); });
+    scheduler.DeferOperation([this, buffer_id] {
+        slot_buffers.erase(buffer_id);
+        scheduler.NotifyResourceDestroyed();
+    });
     buffer.is_deleted = true;
 }
 
@@ -136,6 +136,9 @@ public:
     /// Schedules pending GPU modified ranges since last commit to be copied back the host memory.
     bool CommitPendingDownloads(bool wait_done);
 
+    /// Schedules GDS contents to be written to guest memory once the GPU reaches this point.
+    void DownloadGdsData(u32 gds_offset, VAddr address, u32 num_bytes);
+
     /// Obtains a buffer for the specified region.
     [[nodiscard]] std::pair<Buffer*, u32> ObtainBuffer(VAddr gpu_addr, u32 size, bool is_written,
                                                        bool is_texel_buffer = false,
@@ -242,6 +245,7 @@ private:
     std::shared_mutex slot_buffers_mutex;
     Common::SlotVector<Buffer> slot_buffers;
     RangeSet pending_download_ranges;
+    RangeSet pending_host_write_ranges;
     RangeSet gpu_modified_ranges;
     SplitRangeMap<BufferId> buffer_ranges;
     MemoryTracker memory_tracker;
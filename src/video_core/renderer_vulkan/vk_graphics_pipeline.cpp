@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <algorithm>
+#include <cstring>
 #include <utility>
 #include <boost/container/small_vector.hpp>
 #include <boost/container/static_vector.hpp>
@@ -28,6 +29,65 @@ static constexpr std::array LogicalStageToStageBit = {
     vk::ShaderStageFlagBits::eCompute,
 };
 
+static constexpr vk::ShaderStageFlags PreRasterizationStageBits =
+    vk::ShaderStageFlagBits::eVertex | vk::ShaderStageFlagBits::eTessellationControl |
+    vk::ShaderStageFlagBits::eTessellationEvaluation | vk::ShaderStageFlagBits::eGeometry;
+
+using LibraryFlags = vk::GraphicsPipelineLibraryFlagBitsEXT;
+
+/// Builds the key of the library covering the given state subset. Both shader libraries depend
+/// on every stage because the descriptor set layout is shared by the whole pipeline.
+static GraphicsPipelineLibraryKey MakeLibraryKey(
+    const GraphicsPipelineKey& key, LibraryFlags flags,
+    std::span<const Shader::Info*, MaxShaderStages> infos,
+    std::span<const vk::ShaderModule> modules) {
+    GraphicsPipelineLibraryKey lib_key;
+    std::memset(&lib_key, 0, sizeof(lib_key));
+    lib_key.flags = static_cast<u32>(flags);
+    auto& state = lib_key.state;
+    switch (flags) {
+    case LibraryFlags::eVertexInputInterface: {
+        // Vertex attributes are taken from the fetch shader of the vertex stage.
+        const auto vs_stage = u32(Shader::LogicalStage::Vertex);
+        state.stage_hashes[vs_stage] = key.stage_hashes[vs_stage];
+        state.prim_type = key.prim_type;
+        state.vertex_buffer_formats = key.vertex_buffer_formats;
+        break;
+    }
+    case LibraryFlags::ePreRasterizationShaders:
+    case LibraryFlags::eFragmentShader:
+        state.stage_hashes = key.stage_hashes;
+        for (u32 i = 0; i < MaxShaderStages; ++i) {
+            if (infos[i]) {
+                lib_key.modules[i] = modules[i];
+            }
+        }
+        if (flags == LibraryFlags::ePreRasterizationShaders) {
+            state.prim_type = key.prim_type;
+            state.patch_control_points = key.patch_control_points;
+            state.polygon_mode = key.polygon_mode;
+            state.clip_space = key.clip_space;
+        } else {
+            state.num_samples = key.num_samples;
+        }
+        break;
+    case LibraryFlags::eFragmentOutputInterface:
+        state.num_color_attachments = key.num_color_attachments;
+        state.color_formats = key.color_formats;
+        state.depth_format = key.depth_format;
+        state.stencil_format = key.stencil_format;
+        state.num_samples = key.num_samples;
+        state.mrt_mask = key.mrt_mask;
+        state.cb_shader_mask = key.cb_shader_mask;
+        state.blend_controls = key.blend_controls;
+        state.write_masks = key.write_masks;
+        break;
+    default:
+        UNREACHABLE();
+    }
+    return lib_key;
+}
+
 static bool IsPrimitiveTopologyList(const vk::PrimitiveTopology topology) {
     return topology == vk::PrimitiveTopology::ePointList ||
            topology == vk::PrimitiveTopology::eLineList ||
@@ -40,12 +100,13 @@ static bool IsPrimitiveTopologyList(const vk::PrimitiveTopology topology) {
 GraphicsPipeline::GraphicsPipeline(
     const Instance& instance, Scheduler& scheduler, DescriptorHeap& desc_heap,
     const Shader::Profile& profile, const GraphicsPipelineKey& key_,
-    vk::PipelineCache pipeline_cache, std::span<const Shader::Info*, MaxShaderStages> infos,
+    vk::PipelineCache pipeline_cache, GraphicsPipelineLibraries& library_cache,
+    std::span<const Shader::Info*, MaxShaderStages> infos,
     std::span<const Shader::RuntimeInfo, MaxShaderStages> runtime_infos,
     std::optional<const Shader::Gcn::FetchShaderData> fetch_shader_,
     std::span<const vk::ShaderModule> modules)
     : Pipeline{instance, scheduler, desc_heap, profile, pipeline_cache}, key{key_},
-      fetch_shader{std::move(fetch_shader_)} {
+      fetch_shader{std::move(fetch_shader_)}, vk_pipeline_cache{pipeline_cache} {
     const vk::Device device = instance.GetDevice();
     std::ranges::copy(infos, stages.begin());
     BuildDescSetLayout();
@@ -297,16 +358,105 @@ GraphicsPipeline::GraphicsPipeline(
         .layout = *pipeline_layout,
     };
 
-    auto [pipeline_result, pipe] =
-        device.createGraphicsPipelineUnique(pipeline_cache, pipeline_info);
-    ASSERT_MSG(pipeline_result == vk::Result::eSuccess, "Failed to create graphics pipeline: {}",
-               vk::to_string(pipeline_result));
-    pipeline = std::move(pipe);
+    if (instance.IsGraphicsPipelineLibrarySupported()) {
+        // Fast-link the four pipeline parts from libraries, so the pipeline can be used right
+        // away. Libraries are shared with every pipeline using the same state for their part, so
+        // only the parts that changed are compiled. The link time optimized pipeline is created
+        // later on a worker thread.
+        static constexpr std::array<std::pair<LibraryFlags, vk::ShaderStageFlags>, 4> Parts = {{
+            {LibraryFlags::eVertexInputInterface, {}},
+            {LibraryFlags::ePreRasterizationShaders, PreRasterizationStageBits},
+            {LibraryFlags::eFragmentShader, vk::ShaderStageFlagBits::eFragment},
+            {LibraryFlags::eFragmentOutputInterface, {}},
+        }};
+        for (u32 i = 0; i < Parts.size(); ++i) {
+            const auto [flags, stage_mask] = Parts[i];
+            auto [it, is_new] =
+                library_cache.try_emplace(MakeLibraryKey(key, flags, infos, modules));
+            if (is_new) {
+                it.value() = CreateLibrary(device, pipeline_info, stage_mask, flags);
+            }
+            libraries[i] = *it->second;
+        }
+        pipeline = LinkLibraries(false);
+    } else {
+        auto [pipeline_result, pipe] =
+            device.createGraphicsPipelineUnique(pipeline_cache, pipeline_info);
+        ASSERT_MSG(pipeline_result == vk::Result::eSuccess,
+                   "Failed to create graphics pipeline: {}", vk::to_string(pipeline_result));
+        pipeline = std::move(pipe);
+    }
     SetObjectName(device, *pipeline, "Graphics Pipeline {}", debug_str);
 }
 
 GraphicsPipeline::~GraphicsPipeline() = default;
 
+vk::UniquePipeline GraphicsPipeline::CreateLibrary(vk::Device device,
+                                                   vk::GraphicsPipelineCreateInfo pipeline_info,
+                                                   vk::ShaderStageFlags stage_mask,
+                                                   vk::GraphicsPipelineLibraryFlagBitsEXT flags) {
+    // Each library may only contain the shader stages of the state subset it describes, the
+    // fixed function state outside of the subset is ignored.
+    boost::container::static_vector<vk::PipelineShaderStageCreateInfo, MaxShaderStages>
+        library_stages;
+    for (u32 i = 0; i < pipeline_info.stageCount; ++i) {
+        if (pipeline_info.pStages[i].stage & stage_mask) {
+            library_stages.push_back(pipeline_info.pStages[i]);
+        }
+    }
+    const vk::GraphicsPipelineLibraryCreateInfoEXT library_info = {
+        .pNext = pipeline_info.pNext,
+        .flags = flags,
+    };
+    pipeline_info.pNext = &library_info;
+    pipeline_info.flags |= vk::PipelineCreateFlagBits::eLibraryKHR |
+                           vk::PipelineCreateFlagBits::eRetainLinkTimeOptimizationInfoEXT;
+    pipeline_info.stageCount = static_cast<u32>(library_stages.size());
+    pipeline_info.pStages = library_stages.data();
+
+    auto [library_result, library] =
+        device.createGraphicsPipelineUnique(vk_pipeline_cache, pipeline_info);
+    ASSERT_MSG(library_result == vk::Result::eSuccess,
+               "Failed to create graphics pipeline library: {}", vk::to_string(library_result));
+    return std::move(library);
+}
+
+vk::UniquePipeline GraphicsPipeline::LinkLibraries(bool optimize) const {
+    const vk::PipelineLibraryCreateInfoKHR link_info = {
+        .libraryCount = static_cast<u32>(libraries.size()),
+        .pLibraries = libraries.data(),
+    };
+    const vk::GraphicsPipelineCreateInfo pipeline_info = {
+        .pNext = &link_info,
+        .flags = optimize ? vk::PipelineCreateFlagBits::eLinkTimeOptimizationEXT
+                          : vk::PipelineCreateFlags{},
+        .layout = *pipeline_layout,
+    };
+    auto [link_result, linked] =
+        instance.GetDevice().createGraphicsPipelineUnique(vk_pipeline_cache, pipeline_info);
+    ASSERT_MSG(link_result == vk::Result::eSuccess, "Failed to link graphics pipeline: {}",
+               vk::to_string(link_result));
+    return std::move(linked);
+}
+
+void GraphicsPipeline::LinkOptimized() {
+    optimized_pipeline = LinkLibraries(true);
+    SetObjectName(instance.GetDevice(), *optimized_pipeline, "Graphics Pipeline {}",
+                  GetDebugString());
+    is_optimized.store(true, std::memory_order_release);
+}
+
+void GraphicsPipeline::PromoteOptimized() {
+    if (!is_optimized.load(std::memory_order_acquire) || !optimized_pipeline) {
+        return;
+    }
+    // The fast-linked pipeline may still be referenced by commands in flight.
+    scheduler.DeferOperation([fast_linked = std::move(pipeline)] {});
+    pipeline = std::move(optimized_pipeline);
+    // The libraries are owned by the pipeline cache and stay alive for other pipelines.
+    libraries = {};
+}
+
 template <typename Attribute, typename Binding>
 void GraphicsPipeline::GetVertexInputs(VertexInputs<Attribute>& attributes,
                                        VertexInputs<Binding>& bindings,
@@ -3,7 +3,9 @@
 
 #pragma once
 
+#include <atomic>
 #include <boost/container/static_vector.hpp>
+#include <tsl/robin_map.h>
 #include <xxhash.h>
 
 #include "common/types.h"
@@ -55,11 +57,25 @@ struct GraphicsPipelineKey {
     }
 };
 
+/// The part of the pipeline state consumed by one graphics pipeline library. Fields the library
+/// does not consume are left zero, so pipelines that only differ in those share the library.
+struct GraphicsPipelineLibraryKey {
+    GraphicsPipelineKey state;
+    std::array<vk::ShaderModule, MaxShaderStages> modules;
+    u32 flags;
+
+    bool operator==(const GraphicsPipelineLibraryKey& key) const noexcept {
+        return std::memcmp(this, &key, sizeof(key)) == 0;
+    }
+};
+
+using GraphicsPipelineLibraries = tsl::robin_map<GraphicsPipelineLibraryKey, vk::UniquePipeline>;
+
 class GraphicsPipeline : public Pipeline {
 public:
     GraphicsPipeline(const Instance& instance, Scheduler& scheduler, DescriptorHeap& desc_heap,
                      const Shader::Profile& profile, const GraphicsPipelineKey& key,
-                     vk::PipelineCache pipeline_cache,
+                     vk::PipelineCache pipeline_cache, GraphicsPipelineLibraries& library_cache,
                      std::span<const Shader::Info*, MaxShaderStages> stages,
                      std::span<const Shader::RuntimeInfo, MaxShaderStages> runtime_infos,
                      std::optional<const Shader::Gcn::FetchShaderData> fetch_shader,
@@ -83,12 +99,33 @@ public:
     void GetVertexInputs(VertexInputs<Attribute>& attributes, VertexInputs<Binding>& bindings,
                          VertexInputs<AmdGpu::Buffer>& guest_buffers) const;
 
+    /// Returns true if the pipeline was fast-linked and an optimized link is still outstanding.
+    bool NeedsOptimizedLink() const {
+        return libraries[0] && !is_optimized.load(std::memory_order_relaxed);
+    }
+
+    /// Links the optimized pipeline from the libraries, may be called from a worker thread.
+    void LinkOptimized();
+
+    /// Swaps the fast-linked pipeline with the optimized one when it is ready.
+    void PromoteOptimized();
+
 private:
     void BuildDescSetLayout();
 
+    vk::UniquePipeline CreateLibrary(vk::Device device,
+                                     vk::GraphicsPipelineCreateInfo pipeline_info,
+                                     vk::ShaderStageFlags stage_mask,
+                                     vk::GraphicsPipelineLibraryFlagBitsEXT flags);
+    vk::UniquePipeline LinkLibraries(bool optimize) const;
+
 private:
     GraphicsPipelineKey key;
     std::optional<const Shader::Gcn::FetchShaderData> fetch_shader{};
+    vk::PipelineCache vk_pipeline_cache;
+    std::array<vk::Pipeline, 4> libraries;
+    vk::UniquePipeline optimized_pipeline;
+    std::atomic_bool is_optimized{};
 };
 
 } // namespace Vulkan
@@ -99,3 +136,10 @@ struct std::hash<Vulkan::GraphicsPipelineKey> {
         return XXH3_64bits(&key, sizeof(key));
     }
 };
+
+template <>
+struct std::hash<Vulkan::GraphicsPipelineLibraryKey> {
+    std::size_t operator()(const Vulkan::GraphicsPipelineLibraryKey& key) const noexcept {
+        return XXH3_64bits(&key, sizeof(key));
+    }
+};
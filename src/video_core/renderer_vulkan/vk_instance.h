@@ -89,6 +89,11 @@ public:
         return features.depthBounds;
     }
 
+    /// Returns true if indirect draws can read more than one argument record
+    bool IsMultiDrawIndirectSupported() const {
+        return features.multiDrawIndirect;
+    }
+
     /// Returns true if 64-bit floats are supported in shaders
     bool IsShaderFloat64Supported() const {
         return features.shaderFloat64;
@@ -216,6 +221,11 @@ public:
         return conditional_rendering;
     }
 
+    /// Returns true when VK_EXT_graphics_pipeline_library with fast linking is supported
+    bool IsGraphicsPipelineLibrarySupported() const {
+        return graphics_pipeline_library;
+    }
+
     /// Returns the vendor ID of the physical device
     u32 GetVendorID() const {
         return properties.vendorID;
@@ -291,6 +301,11 @@ public:
         return properties.limits.maxComputeSharedMemorySize;
     }
 
+    /// Returns the maximum draw count of a single indirect draw.
+    u32 MaxDrawIndirectCount() const {
+        return properties.limits.maxDrawIndirectCount;
+    }
+
     /// Returns the maximum sampler LOD bias.
     float MaxSamplerLodBias() const {
         return properties.limits.maxSamplerLodBias;
@@ -404,6 +419,7 @@ private:
     bool workgroup_memory_explicit_layout{};
     bool dynamic_rendering_unused_attachments{};
     bool conditional_rendering{};
+    bool graphics_pipeline_library{};
     bool portability_subset{};
 };
 
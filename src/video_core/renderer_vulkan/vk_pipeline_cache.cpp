@@ -4,9 +4,12 @@
 #include <ranges>
 
 #include "common/config.h"
+#include "common/elf_info.h"
 #include "common/hash.h"
 #include "common/io_file.h"
 #include "common/path_util.h"
+#include "common/polyfill_thread.h"
+#include "common/thread.h"
 #include "core/debug_state.h"
 #include "shader_recompiler/backend/spirv/emit_spirv.h"
 #include "shader_recompiler/info.h"
@@ -16,6 +19,7 @@
 #include "video_core/renderer_vulkan/vk_pipeline_cache.h"
 #include "video_core/renderer_vulkan/vk_presenter.h"
 #include "video_core/renderer_vulkan/vk_scheduler.h"
+#include "video_core/renderer_vulkan/vk_shader_optimizer.h"
 #include "video_core/renderer_vulkan/vk_shader_util.h"
 
 extern std::unique_ptr<Vulkan::Presenter> presenter;
@@ -35,6 +39,22 @@ constexpr static std::array DescriptorHeapSizes = {
     vk::DescriptorPoolSize{vk::DescriptorType::eSampler, 1024},
 };
 
+/// Number of newly created pipelines after which the driver pipeline cache is written to disk.
+constexpr static u32 PipelineCacheSaveInterval = 128;
+
+/// The driver cache stands in for precompiling pipelines from a manifest of the keys used in
+/// previous sessions. Recreating a pipeline from its key needs the recompiled modules, and those
+/// only exist once the title has bound the guest shader code.
+/// Empty when the title has no serial, the cache would otherwise be shared across titles.
+static std::filesystem::path GetPipelineCachePath() {
+    using namespace Common::FS;
+    const auto serial = Common::ElfInfo::Instance().GameSerial();
+    if (serial.empty()) {
+        return {};
+    }
+    return GetUserPath(PathType::ShaderDir) / "pipelines" / fmt::format("{}.bin", serial);
+}
+
 void GatherVertexOutputs(Shader::VertexRuntimeInfo& info,
                          const AmdGpu::Liverpool::VsOutputControl& ctl) {
     const auto add_output = [&](VsOutput x, VsOutput y, VsOutput z, VsOutput w) {
@@ -233,13 +253,130 @@ PipelineCache::PipelineCache(const Instance& instance_, Scheduler& scheduler_,
         .max_viewport_height = instance.GetMaxViewportHeight(),
         .max_shared_memory_size = instance.MaxComputeSharedMemorySize(),
     };
-    auto [cache_result, cache] = instance.GetDevice().createPipelineCacheUnique({});
+
+    // Seed the driver cache with the pipelines compiled in previous sessions of this title, the
+    // driver discards the data if it was produced by a different device or driver version.
+    std::vector<u8> cache_data;
+    const auto cache_path = GetPipelineCachePath();
+    if (!cache_path.empty() && std::filesystem::exists(cache_path)) {
+        const Common::FS::IOFile file{cache_path, Common::FS::FileAccessMode::Read};
+        cache_data.resize(file.GetSize());
+        file.Read(cache_data);
+        LOG_INFO(Render_Vulkan, "Loaded {} bytes of pipeline cache data", cache_data.size());
+    }
+    const vk::PipelineCacheCreateInfo cache_info = {
+        .initialDataSize = cache_data.size(),
+        .pInitialData = cache_data.data(),
+    };
+    auto [cache_result, cache] = instance.GetDevice().createPipelineCacheUnique(cache_info);
     ASSERT_MSG(cache_result == vk::Result::eSuccess, "Failed to create pipeline cache: {}",
                vk::to_string(cache_result));
     pipeline_cache = std::move(cache);
+    if (instance.IsGraphicsPipelineLibrarySupported()) {
+        optimize_thread = std::jthread{std::bind_front(&PipelineCache::OptimizeThread, this)};
+    }
+    save_thread = std::jthread{std::bind_front(&PipelineCache::SaveThread, this)};
+}
+
+PipelineCache::~PipelineCache() {
+    // Let a periodic save finish before writing the final state.
+    save_thread.request_stop();
+    save_thread.join();
+    SavePipelineCache();
+}
+
+void PipelineCache::SavePipelineCache() {
+    const auto cache_path = GetPipelineCachePath();
+    if (cache_path.empty()) {
+        return;
+    }
+    auto [data_result, data] = instance.GetDevice().getPipelineCacheData(*pipeline_cache);
+    if (data_result != vk::Result::eSuccess) {
+        LOG_ERROR(Render_Vulkan, "Failed to get pipeline cache data: {}",
+                  vk::to_string(data_result));
+        return;
+    }
+    // Write next to the cache and move it in place, so a crash or a failed write never replaces
+    // the previous cache with a truncated file.
+    std::filesystem::create_directories(cache_path.parent_path());
+    auto temp_path = cache_path;
+    temp_path += ".tmp";
+    bool written;
+    {
+        const Common::FS::IOFile file{temp_path, Common::FS::FileAccessMode::Write};
+        written = file.WriteSpan(std::span<const u8>{data}) == data.size();
+    }
+    std::error_code ec;
+    if (!written) {
+        LOG_ERROR(Render_Vulkan, "Failed to write pipeline cache to {}", temp_path.string());
+        std::filesystem::remove(temp_path, ec);
+        return;
+    }
+    std::filesystem::rename(temp_path, cache_path, ec);
+    if (ec) {
+        LOG_ERROR(Render_Vulkan, "Failed to save pipeline cache: {}", ec.message());
+    }
+}
+
+void PipelineCache::OnPipelineCreated() {
+    if (++num_new_pipelines % PipelineCacheSaveInterval == 0) {
+        // Serializing the cache can take a while, keep it off the GPU thread.
+        {
+            std::scoped_lock lk{save_mutex};
+            save_requested = true;
+        }
+        save_cv.notify_one();
+    }
 }
 
-PipelineCache::~PipelineCache() = default;
+void PipelineCache::SaveThread(std::stop_token stoken) {
+    Common::SetCurrentThreadName("shadPS4:PipelineCacheSaver");
+
+    while (!stoken.stop_requested()) {
+        {
+            std::unique_lock lk{save_mutex};
+            Common::CondvarWait(save_cv, lk, stoken, [this] { return save_requested; });
+            if (stoken.stop_requested()) {
+                break;
+            }
+            save_requested = false;
+        }
+        SavePipelineCache();
+    }
+}
+
+void PipelineCache::OptimizeThread(std::stop_token stoken) {
+    Common::SetCurrentThreadName("shadPS4:PipelineOptimizer");
+
+    while (!stoken.stop_requested()) {
+        {
+            std::unique_lock lk{optimize_mutex};
+            Common::CondvarWait(optimize_cv, lk, stoken,
+                                [this] { return !optimize_queue.empty(); });
+            if (stoken.stop_requested()) {
+                break;
+            }
+            optimizing_pipeline = optimize_queue.front();
+            optimize_queue.pop_front();
+        }
+
+        optimizing_pipeline->LinkOptimized();
+
+        std::scoped_lock lk{optimize_mutex};
+        optimizing_pipeline = nullptr;
+        optimize_cv.notify_all();
+    }
+}
+
+void PipelineCache::CancelOptimizations(std::span<const GraphicsPipeline* const> pipelines) {
+    std::unique_lock lk{optimize_mutex};
+    std::erase_if(optimize_queue, [pipelines](const GraphicsPipeline* pipeline) {
+        return std::ranges::contains(pipelines, pipeline);
+    });
+    optimize_cv.wait(lk, [this, pipelines] {
+        return !std::ranges::contains(pipelines, optimizing_pipeline);
+    });
+}
 
 const GraphicsPipeline* PipelineCache::GetGraphicsPipeline() {
     if (!RefreshGraphicsKey()) {
@@ -248,8 +385,15 @@ const GraphicsPipeline* PipelineCache::GetGraphicsPipeline() {
     const auto [it, is_new] = graphics_pipelines.try_emplace(graphics_key);
     if (is_new) {
         it.value() = std::make_unique<GraphicsPipeline>(instance, scheduler, desc_heap, profile,
-                                                        graphics_key, *pipeline_cache, infos,
-                                                        runtime_infos, fetch_shader, modules);
+                                                        graphics_key, *pipeline_cache,
+                                                        graphics_libraries, infos, runtime_infos,
+                                                        fetch_shader, modules);
+        OnPipelineCreated();
+        if (it->second->NeedsOptimizedLink()) {
+            std::scoped_lock lk{optimize_mutex};
+            optimize_queue.push_back(it->second.get());
+            optimize_cv.notify_one();
+        }
         if (Config::collectShadersForDebug()) {
             for (auto stage = 0; stage < MaxShaderStages; ++stage) {
                 if (infos[stage]) {
@@ -258,6 +402,8 @@ const GraphicsPipeline* PipelineCache::GetGraphicsPipeline() {
                 }
             }
         }
+    } else {
+        it.value()->PromoteOptimized();
     }
     return it->second.get();
 }
@@ -271,6 +417,7 @@ const ComputePipeline* PipelineCache::GetComputePipeline() {
         it.value() =
             std::make_unique<ComputePipeline>(instance, scheduler, desc_heap, profile,
                                               *pipeline_cache, compute_key, *infos[0], modules[0]);
+        OnPipelineCreated();
         if (Config::collectShadersForDebug()) {
             auto& m = modules[0];
             module_related_pipelines[m].emplace_back(compute_key);
@@ -544,6 +691,8 @@ vk::ShaderModule PipelineCache::CompileModule(Shader::Info& info, Shader::Runtim
     if (is_patched) {
         LOG_INFO(Loader, "Loaded patch for {} shader {:#x}", info.stage, info.pgm_hash);
         module = CompileSPV(*patch, instance.GetDevice());
+    } else if (const auto optimized = OptimizeSPV(spv)) {
+        module = CompileSPV(*optimized, instance.GetDevice());
     } else {
         module = CompileSPV(spv, instance.GetDevice());
     }
@@ -610,6 +759,17 @@ std::optional<vk::ShaderModule> PipelineCache::ReplaceShader(vk::ShaderModule mo
     }
     if (module_related_pipelines.contains(module)) {
         auto& pipeline_keys = module_related_pipelines[module];
+        // Pipelines about to be destroyed may still be queued for optimization.
+        std::vector<const GraphicsPipeline*> obsolete_pipelines;
+        for (auto& key : pipeline_keys) {
+            if (std::holds_alternative<GraphicsPipelineKey>(key)) {
+                const auto it = graphics_pipelines.find(std::get<GraphicsPipelineKey>(key));
+                if (it != graphics_pipelines.end()) {
+                    obsolete_pipelines.push_back(it->second.get());
+                }
+            }
+        }
+        CancelOptimizations(obsolete_pipelines);
         for (auto& key : pipeline_keys) {
             if (std::holds_alternative<GraphicsPipelineKey>(key)) {
                 auto& graphics_key = std::get<GraphicsPipelineKey>(key);
@@ -619,6 +779,15 @@ std::optional<vk::ShaderModule> PipelineCache::ReplaceShader(vk::ShaderModule mo
                 compute_pipelines.erase(compute_key);
             }
         }
+        // Only the pipelines above linked libraries built from the module, whose handle may be
+        // reused by the replacement.
+        for (auto it = graphics_libraries.begin(); it != graphics_libraries.end();) {
+            if (std::ranges::contains(it->first.modules, module)) {
+                it = graphics_libraries.erase(it);
+            } else {
+                ++it;
+            }
+        }
     }
     return new_module;
 }
@@ -3,6 +3,10 @@
 
 #pragma once
 
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
 #include <variant>
 #include <tsl/robin_map.h>
 #include "shader_recompiler/profile.h"
@@ -85,6 +89,13 @@ private:
                                    Shader::Backend::Bindings& binding);
     const Shader::RuntimeInfo& BuildRuntimeInfo(Shader::Stage stage, Shader::LogicalStage l_stage);
 
+    void SavePipelineCache();
+    void OnPipelineCreated();
+    void SaveThread(std::stop_token stoken);
+
+    void OptimizeThread(std::stop_token stoken);
+    void CancelOptimizations(std::span<const GraphicsPipeline* const> pipelines);
+
 private:
     const Instance& instance;
     Scheduler& scheduler;
@@ -97,17 +108,31 @@ private:
     tsl::robin_map<size_t, std::unique_ptr<Program>> program_cache;
     tsl::robin_map<ComputePipelineKey, std::unique_ptr<ComputePipeline>> compute_pipelines;
     tsl::robin_map<GraphicsPipelineKey, std::unique_ptr<GraphicsPipeline>> graphics_pipelines;
+    GraphicsPipelineLibraries graphics_libraries;
     std::array<Shader::RuntimeInfo, MaxShaderStages> runtime_infos{};
     std::array<const Shader::Info*, MaxShaderStages> infos{};
     std::array<vk::ShaderModule, MaxShaderStages> modules{};
     std::optional<Shader::Gcn::FetchShaderData> fetch_shader{};
     GraphicsPipelineKey graphics_key{};
     ComputePipelineKey compute_key{};
+    u32 num_new_pipelines{};
+    bool save_requested{};
+    std::mutex save_mutex;
+    std::condition_variable_any save_cv;
+    std::jthread save_thread;
 
     // Only if Config::collectShadersForDebug()
     tsl::robin_map<vk::ShaderModule,
                    std::vector<std::variant<GraphicsPipelineKey, ComputePipelineKey>>>
         module_related_pipelines;
+
+    // Fast-linked graphics pipelines waiting for their optimized link. Declared last so that the
+    // worker is stopped before any pipeline is destroyed.
+    std::deque<GraphicsPipeline*> optimize_queue;
+    GraphicsPipeline* optimizing_pipeline{};
+    std::mutex optimize_mutex;
+    std::condition_variable_any optimize_cv;
+    std::jthread optimize_thread;
 };
 
 } // namespace Vulkan
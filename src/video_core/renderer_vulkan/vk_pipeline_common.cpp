@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <boost/container/static_vector.hpp>
+#include <xxhash.h>
 
 #include "shader_recompiler/info.h"
 #include "video_core/buffer_cache/buffer_cache.h"
@@ -21,6 +22,27 @@ Pipeline::Pipeline(const Instance& instance_, Scheduler& scheduler_, DescriptorH
 
 Pipeline::~Pipeline() = default;
 
+static void GetDescriptorContents(const Pipeline::DescriptorWrites& set_writes,
+                                  vk::PipelineLayout layout, DescriptorSetContents& contents) {
+    contents.push_back(std::bit_cast<u64>(layout));
+    for (const auto& set_write : set_writes) {
+        contents.push_back(u64{set_write.dstBinding} << 32 |
+                           static_cast<u32>(set_write.descriptorType));
+        for (u32 i = 0; i < set_write.descriptorCount; ++i) {
+            if (const auto* buffer_info = set_write.pBufferInfo) {
+                contents.push_back(std::bit_cast<u64>(buffer_info[i].buffer));
+                contents.push_back(buffer_info[i].offset);
+                contents.push_back(buffer_info[i].range);
+            }
+            if (const auto* image_info = set_write.pImageInfo) {
+                contents.push_back(std::bit_cast<u64>(image_info[i].sampler));
+                contents.push_back(std::bit_cast<u64>(image_info[i].imageView));
+                contents.push_back(static_cast<u64>(image_info[i].imageLayout));
+            }
+        }
+    }
+}
+
 void Pipeline::BindResources(DescriptorWrites& set_writes, const BufferBarriers& buffer_barriers,
                              const Shader::PushData& push_data) const {
     const auto cmdbuf = scheduler.CommandBuffer();
@@ -37,24 +59,43 @@ void Pipeline::BindResources(DescriptorWrites& set_writes, const BufferBarriers&
         cmdbuf.pipelineBarrier2(dependencies);
     }
 
-    const auto stage_flags = IsCompute() ? vk::ShaderStageFlagBits::eCompute : AllGraphicsStageBits;
-    cmdbuf.pushConstants(*pipeline_layout, stage_flags, 0u, sizeof(push_data), &push_data);
+    // Runs of draws frequently share user data, only upload push constants when they change.
+    if (!scheduler.IsPushDataBound(bind_point, *pipeline_layout, &push_data, sizeof(push_data))) {
+        const auto stage_flags =
+            IsCompute() ? vk::ShaderStageFlagBits::eCompute : AllGraphicsStageBits;
+        cmdbuf.pushConstants(*pipeline_layout, stage_flags, 0u, sizeof(push_data), &push_data);
+        scheduler.SetBoundPushData(bind_point, *pipeline_layout, &push_data, sizeof(push_data));
+    }
 
     // Bind descriptor set.
     if (set_writes.empty()) {
         return;
     }
 
+    // Consecutive draws and dispatches often bind identical resources, skip redundant updates.
+    DescriptorSetContents contents;
+    GetDescriptorContents(set_writes, *pipeline_layout, contents);
+    if (scheduler.IsDescriptorSetBound(bind_point, *pipeline_layout, contents)) {
+        return;
+    }
+    scheduler.SetBoundDescriptorSet(bind_point, *pipeline_layout, contents);
+
     if (uses_push_descriptors) {
         cmdbuf.pushDescriptorSetKHR(bind_point, *pipeline_layout, 0, set_writes);
         return;
     }
 
-    const auto desc_set = desc_heap.Commit(*desc_layout);
-    for (auto& set_write : set_writes) {
-        set_write.dstSet = desc_set;
+    const u64 contents_hash = XXH3_64bits(contents.data(), contents.size() * sizeof(u64));
+    auto desc_set =
+        desc_heap.FindCommitted(contents, contents_hash, scheduler.ResourceGeneration());
+    if (!desc_set) {
+        desc_set = desc_heap.Commit(*desc_layout);
+        for (auto& set_write : set_writes) {
+            set_write.dstSet = desc_set;
+        }
+        instance.GetDevice().updateDescriptorSets(set_writes, {});
+        desc_heap.RegisterCommitted(std::move(contents), contents_hash, desc_set);
     }
-    instance.GetDevice().updateDescriptorSets(set_writes, {});
     cmdbuf.bindDescriptorSets(bind_point, *pipeline_layout, 0, desc_set, {});
 }
 
@@ -373,6 +373,7 @@ Frame* Presenter::PrepareFrameInternal(VideoCore::ImageId image_id,
             });
         }
         pp_pass.Render(cmdbuf, imageView, image_size, *frame, pp_settings);
+        scheduler.InvalidateBindings();
         if (vk_host_markers_enabled) {
             cmdbuf.endDebugUtilsLabelEXT();
         }
@@ -4,6 +4,7 @@
 #include "common/config.h"
 #include "common/debug.h"
 #include "common/scope_exit.h"
+#include "core/debug_state.h"
 #include "core/memory.h"
 #include "shader_recompiler/runtime_info.h"
 #include "video_core/amdgpu/liverpool.h"
@@ -349,7 +350,7 @@ void Rasterizer::Draw(bool is_indexed, u32 index_offset) {
     const auto [vertex_offset, instance_offset] = GetDrawOffsets(regs, vs_info, fetch_shader);
 
     const auto cmdbuf = scheduler.CommandBuffer();
-    cmdbuf.bindPipeline(vk::PipelineBindPoint::eGraphics, pipeline->Handle());
+    DebugState.CountDraw(BindPipeline(pipeline));
 
     for (auto samples : UniqueSampleCounts()) {
         auto state = full_state;
@@ -430,13 +431,14 @@ void Rasterizer::DrawIndirect(bool is_indexed, VAddr arg_address, u32 offset, u3
     // instance offsets will be automatically applied by Vulkan from indirect args buffer.
 
     const auto cmdbuf = scheduler.CommandBuffer();
-    cmdbuf.bindPipeline(vk::PipelineBindPoint::eGraphics, pipeline->Handle());
+    DebugState.CountDraw(BindPipeline(pipeline));
 
     if (active_predication) {
         cmdbuf.beginConditionalRenderingEXT(&*active_predication);
     }
     if (is_indexed) {
-        ASSERT(sizeof(VkDrawIndexedIndirectCommand) == stride);
+        ASSERT_MSG(stride >= sizeof(VkDrawIndexedIndirectCommand) && stride % 4 == 0,
+                   "Unsupported indexed indirect args stride {}", stride);
 
         if (count_address != 0) {
             cmdbuf.drawIndexedIndirectCount(buffer->Handle(), base, count_buffer->Handle(),
@@ -445,7 +447,8 @@ void Rasterizer::DrawIndirect(bool is_indexed, VAddr arg_address, u32 offset, u3
             cmdbuf.drawIndexedIndirect(buffer->Handle(), base, max_count, stride);
         }
     } else {
-        ASSERT(sizeof(VkDrawIndirectCommand) == stride);
+        ASSERT_MSG(stride >= sizeof(VkDrawIndirectCommand) && stride % 4 == 0,
+                   "Unsupported indirect args stride {}", stride);
 
         if (count_address != 0) {
             cmdbuf.drawIndirectCount(buffer->Handle(), base, count_buffer->Handle(), count_base,
@@ -460,6 +463,13 @@ void Rasterizer::DrawIndirect(bool is_indexed, VAddr arg_address, u32 offset, u3
     ResetBindings();
 }
 
+u32 Rasterizer::MaxIndirectDrawBatch() const noexcept {
+    if (!instance.IsMultiDrawIndirectSupported()) {
+        return 1;
+    }
+    return std::max(instance.MaxDrawIndirectCount(), 1u);
+}
+
 void Rasterizer::DispatchDirect() {
     RENDERER_TRACE;
 
@@ -483,7 +493,7 @@ void Rasterizer::DispatchDirect() {
     scheduler.EndRendering();
 
     const auto cmdbuf = scheduler.CommandBuffer();
-    cmdbuf.bindPipeline(vk::PipelineBindPoint::eCompute, pipeline->Handle());
+    BindPipeline(pipeline);
     cmdbuf.dispatch(cs_program.dim_x, cs_program.dim_y, cs_program.dim_z);
 
     ResetBindings();
@@ -509,7 +519,7 @@ void Rasterizer::DispatchIndirect(VAddr address, u32 offset, u32 size) {
     const auto [buffer, base] = buffer_cache.ObtainBuffer(address + offset, size, false);
 
     const auto cmdbuf = scheduler.CommandBuffer();
-    cmdbuf.bindPipeline(vk::PipelineBindPoint::eCompute, pipeline->Handle());
+    BindPipeline(pipeline);
     cmdbuf.dispatchIndirect(buffer->Handle(), base);
 
     ResetBindings();
@@ -533,6 +543,17 @@ void Rasterizer::ProcessFaults() {
     }
 }
 
+bool Rasterizer::BindPipeline(const Pipeline* pipeline) {
+    const auto bind_point = pipeline->IsCompute() ? vk::PipelineBindPoint::eCompute
+                                                  : vk::PipelineBindPoint::eGraphics;
+    if (scheduler.IsPipelineBound(bind_point, pipeline->Handle())) {
+        return true;
+    }
+    scheduler.CommandBuffer().bindPipeline(bind_point, pipeline->Handle());
+    scheduler.SetBoundPipeline(bind_point, pipeline->Handle());
+    return false;
+}
+
 bool Rasterizer::BindResources(const Pipeline* pipeline) {
     if (IsComputeMetaClear(pipeline)) {
         return false;
@@ -682,9 +703,8 @@ void Rasterizer::BindTextures(const Shader::Info& stage, Shader::Backend::Bindin
             continue;
         }
 
-        auto& [image_id, desc] = image_bindings.emplace_back(std::piecewise_construct, std::tuple{},
-                                                             std::tuple{tsharp, image_desc});
-        image_id = texture_cache.FindImage(desc);
+        auto& [image_id, desc] = image_bindings.emplace_back();
+        image_id = texture_cache.FindTextureImage(tsharp, image_desc, desc);
         auto* image = &texture_cache.GetImage(image_id);
         if (image->depth_id) {
             // If this image has an associated depth image, it's a stencil attachment.
@@ -789,6 +809,18 @@ void Rasterizer::BindTextures(const Shader::Info& stage, Shader::Backend::Bindin
     }
 }
 
+/// Images that were never transitioned since creation hold no data worth loading.
+static bool HasDefinedContents(const VideoCore::Image& image) {
+    return image.last_state.layout != vk::ImageLayout::eUndefined ||
+           !image.subresource_states.empty();
+}
+
+static void DiscardLoad(vk::RenderingAttachmentInfo& attachment) {
+    if (attachment.loadOp == vk::AttachmentLoadOp::eLoad) {
+        attachment.loadOp = vk::AttachmentLoadOp::eDontCare;
+    }
+}
+
 void Rasterizer::BeginRendering(const GraphicsPipeline& pipeline, RenderState& state) {
     int cb_index = 0;
     for (auto attach_idx = 0u; attach_idx < state.num_color_attachments; ++attach_idx) {
@@ -810,6 +842,9 @@ void Rasterizer::BeginRendering(const GraphicsPipeline& pipeline, RenderState& s
             state.height = std::min<u32>(state.height, std::max(image.info.size.height >> mip, 1u));
         }
         auto& image = texture_cache.GetImage(image_id);
+        if (!HasDefinedContents(image)) {
+            DiscardLoad(state.color_attachments[attach_idx]);
+        }
         if (image.binding.force_general) {
             image.Transit(
                 vk::ImageLayout::eGeneral,
@@ -834,6 +869,10 @@ void Rasterizer::BeginRendering(const GraphicsPipeline& pipeline, RenderState& s
         if (has_stencil) {
             image.aspect_mask |= vk::ImageAspectFlagBits::eStencil;
         }
+        if (!HasDefinedContents(image)) {
+            DiscardLoad(state.depth_attachment);
+            DiscardLoad(state.stencil_attachment);
+        }
         if (image.binding.force_general) {
             image.Transit(vk::ImageLayout::eGeneral,
                           vk::AccessFlagBits2::eDepthStencilAttachmentWrite |
@@ -1011,11 +1050,8 @@ void Rasterizer::CopyBuffer(VAddr dst, VAddr src, u32 num_bytes, bool dst_gds, b
     buffer_cache.CopyBuffer(dst, src, num_bytes, dst_gds, src_gds);
 }
 
-u32 Rasterizer::ReadDataFromGds(u32 gds_offset) {
-    auto* gds_buf = buffer_cache.GetGdsBuffer();
-    u32 value;
-    std::memcpy(&value, gds_buf->mapped_data.data() + gds_offset, sizeof(u32));
-    return value;
+void Rasterizer::WriteGdsToMemory(u32 gds_offset, VAddr address, u32 num_bytes) {
+    buffer_cache.DownloadGdsData(gds_offset, address, num_bytes);
 }
 
 bool Rasterizer::InvalidateMemory(VAddr addr, u64 size) {
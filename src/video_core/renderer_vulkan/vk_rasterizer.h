@@ -46,6 +46,9 @@ public:
     void DrawIndirect(bool is_indexed, VAddr arg_address, u32 offset, u32 size, u32 max_count,
                       VAddr count_address);
 
+    /// Returns how many consecutive indirect draw packets can be issued as one multi-draw.
+    [[nodiscard]] u32 MaxIndirectDrawBatch() const noexcept;
+
     void DispatchDirect();
     void DispatchIndirect(VAddr address, u32 offset, u32 size);
 
@@ -62,7 +65,7 @@ public:
 
     void InlineData(VAddr address, const void* value, u32 num_bytes, bool is_gds);
     void CopyBuffer(VAddr dst, VAddr src, u32 num_bytes, bool dst_gds, bool src_gds);
-    u32 ReadDataFromGds(u32 gsd_offset);
+    void WriteGdsToMemory(u32 gds_offset, VAddr address, u32 num_bytes);
     bool InvalidateMemory(VAddr addr, u64 size);
     bool ReadMemory(VAddr addr, u64 size);
     bool IsMapped(VAddr addr, u64 size);
@@ -109,6 +112,8 @@ private:
 
     void BindTextures(const Shader::Info& stage, Shader::Backend::Bindings& binding);
 
+    /// Binds the pipeline unless it is still bound, returns true if the bind was skipped.
+    bool BindPipeline(const Pipeline* pipeline);
     bool BindResources(const Pipeline* pipeline);
     void ResetBindings() {
         for (auto& image_id : bound_images) {
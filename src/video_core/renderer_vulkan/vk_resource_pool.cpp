@@ -167,8 +167,9 @@ vk::DescriptorSet DescriptorHeap::Commit(vk::DescriptorSetLayout set_layout) {
     ASSERT_MSG(result == vk::Result::eSuccess,
                "Unexpected error during descriptor set allocation {}", vk::to_string(result));
 
-    // We've changed pool so also reset descriptor batch cache.
+    // We've changed pool so also reset descriptor batch and committed set caches.
     descriptor_sets.clear();
+    committed_sets.clear();
     const auto desc_set = desc_sets.back();
     desc_sets.pop_back();
     descriptor_sets[set_key] = std::move(desc_sets);
@@ -5,6 +5,7 @@
 
 #include <deque>
 #include <vector>
+#include <boost/container/small_vector.hpp>
 #include <boost/container/static_vector.hpp>
 #include <tsl/robin_map.h>
 
@@ -16,6 +17,10 @@ namespace Vulkan {
 class Instance;
 class MasterSemaphore;
 
+/// Handles, ranges and layouts written to a descriptor set, one value per word. Hashes of it only
+/// index lookups, a hit is confirmed by comparing the contents themselves.
+using DescriptorSetContents = boost::container::small_vector<u64, 64>;
+
 /**
  * Handles a pool of resources protected by fences. Manages resource overflow allocating more
  * resources.
@@ -75,6 +80,31 @@ public:
 
     vk::DescriptorSet Commit(vk::DescriptorSetLayout set_layout);
 
+    /// Returns a set committed from the current pool with identical contents, if any. Sets are
+    /// keyed by raw handles, so all of them are dropped once a resource has been destroyed and
+    /// its handle could be reused by a new object.
+    vk::DescriptorSet FindCommitted(const DescriptorSetContents& contents, u64 contents_hash,
+                                    u64 resource_generation) {
+        if (resource_generation != committed_generation) {
+            committed_sets.clear();
+            committed_generation = resource_generation;
+            return {};
+        }
+        const auto it = committed_sets.find(contents_hash);
+        if (it == committed_sets.end() || it->second.contents != contents) {
+            return {};
+        }
+        return it->second.desc_set;
+    }
+
+    /// Records the contents written to a committed set so it can be reused. A set with colliding
+    /// contents hash is replaced.
+    void RegisterCommitted(DescriptorSetContents contents, u64 contents_hash,
+                           vk::DescriptorSet desc_set) {
+        committed_sets.insert_or_assign(contents_hash,
+                                        CommittedSet{std::move(contents), desc_set});
+    }
+
 private:
     void CreateDescriptorPool();
 
@@ -87,6 +117,12 @@ private:
     std::deque<std::pair<vk::DescriptorPool, u64>> pending_pools;
     using DescSetBatch = boost::container::static_vector<vk::DescriptorSet, DescriptorSetBatch>;
     tsl::robin_map<u64, DescSetBatch> descriptor_sets;
+    struct CommittedSet {
+        DescriptorSetContents contents;
+        vk::DescriptorSet desc_set;
+    };
+    tsl::robin_map<u64, CommittedSet> committed_sets;
+    u64 committed_generation{};
 };
 
 } // namespace Vulkan
@@ -4,6 +4,7 @@
 #include <mutex>
 #include "common/assert.h"
 #include "common/debug.h"
+#include "core/debug_state.h"
 #include "imgui/renderer/texture_manager.h"
 #include "video_core/renderer_vulkan/vk_instance.h"
 #include "video_core/renderer_vulkan/vk_scheduler.h"
@@ -29,23 +30,19 @@ Scheduler::~Scheduler() {
 }
 
 void Scheduler::BeginRendering(const RenderState& new_state) {
-    if (is_rendering && render_state == new_state) {
+    if (is_rendering && (render_state == new_state || MergeRendering(new_state))) {
         return;
     }
     EndRendering();
     is_rendering = true;
     render_state = new_state;
-
-    const auto width =
-        render_state.width != std::numeric_limits<u32>::max() ? render_state.width : 1;
-    const auto height =
-        render_state.height != std::numeric_limits<u32>::max() ? render_state.height : 1;
+    DebugState.CountRenderPass();
 
     const vk::RenderingInfo rendering_info = {
         .renderArea =
             {
                 .offset = {0, 0},
-                .extent = {width, height},
+                .extent = RenderArea(),
             },
         .layerCount = 1,
         .colorAttachmentCount = render_state.num_color_attachments,
@@ -59,6 +56,61 @@ void Scheduler::BeginRendering(const RenderState& new_state) {
     current_cmdbuf.beginRendering(rendering_info);
 }
 
+vk::Extent2D Scheduler::RenderArea() const {
+    const auto width =
+        render_state.width != std::numeric_limits<u32>::max() ? render_state.width : 1;
+    const auto height =
+        render_state.height != std::numeric_limits<u32>::max() ? render_state.height : 1;
+    return {width, height};
+}
+
+bool Scheduler::MergeRendering(const RenderState& new_state) {
+    // A pass that targets the same attachments can continue the current one. Attachments the new
+    // state loads already hold their contents, the ones it clears are cleared inside the pass.
+    RenderState merged_state = new_state;
+    boost::container::static_vector<vk::ClearAttachment, 10> clears;
+    const auto merge_attachment = [&](vk::RenderingAttachmentInfo& attachment,
+                                      const vk::RenderingAttachmentInfo& current,
+                                      vk::ImageAspectFlags aspect, u32 index) {
+        if (attachment.loadOp == vk::AttachmentLoadOp::eClear) {
+            clears.push_back({
+                .aspectMask = aspect,
+                .colorAttachment = index,
+                .clearValue = attachment.clearValue,
+            });
+        }
+        attachment.loadOp = current.loadOp;
+        attachment.clearValue = current.clearValue;
+    };
+    for (u32 i = 0; i < merged_state.num_color_attachments; ++i) {
+        if (merged_state.color_attachments[i].imageView) {
+            merge_attachment(merged_state.color_attachments[i], render_state.color_attachments[i],
+                             vk::ImageAspectFlagBits::eColor, i);
+        }
+    }
+    if (merged_state.has_depth) {
+        merge_attachment(merged_state.depth_attachment, render_state.depth_attachment,
+                         vk::ImageAspectFlagBits::eDepth, 0);
+    }
+    if (merged_state.has_stencil) {
+        merge_attachment(merged_state.stencil_attachment, render_state.stencil_attachment,
+                         vk::ImageAspectFlagBits::eStencil, 0);
+    }
+    if (!(merged_state == render_state)) {
+        return false;
+    }
+
+    if (!clears.empty()) {
+        const vk::ClearRect clear_rect = {
+            .rect = {.offset = {0, 0}, .extent = RenderArea()},
+            .baseArrayLayer = 0,
+            .layerCount = 1,
+        };
+        current_cmdbuf.clearAttachments(clears, clear_rect);
+    }
+    return true;
+}
+
 void Scheduler::EndRendering() {
     if (!is_rendering) {
         return;
@@ -118,6 +170,7 @@ void Scheduler::AllocateWorkerCommandBuffers() {
 
     // Invalidate dynamic state so it gets applied to the new command buffer.
     dynamic_state.Invalidate();
+    InvalidateBindings();
 
 #if TRACY_GPU_ENABLED
     auto* profiler_ctx = instance.GetProfilerContext();
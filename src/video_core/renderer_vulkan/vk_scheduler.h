@@ -4,6 +4,7 @@
 #pragma once
 
 #include <condition_variable>
+#include <cstring>
 #include <boost/container/static_vector.hpp>
 #include "common/types.h"
 #include "common/unique_function.h"
@@ -345,6 +346,57 @@ public:
         return dynamic_state;
     }
 
+    /// Returns true if the provided pipeline is still bound.
+    [[nodiscard]] bool IsPipelineBound(vk::PipelineBindPoint bind_point,
+                                       vk::Pipeline pipeline) const {
+        return bind_states[BindPointIndex(bind_point)].pipeline == pipeline;
+    }
+
+    /// Records the pipeline bound at the provided bind point.
+    void SetBoundPipeline(vk::PipelineBindPoint bind_point, vk::Pipeline pipeline) {
+        bind_states[BindPointIndex(bind_point)].pipeline = pipeline;
+    }
+
+    /// Returns true if push constants with the provided contents are still set.
+    [[nodiscard]] bool IsPushDataBound(vk::PipelineBindPoint bind_point, vk::PipelineLayout layout,
+                                       const void* data, u32 size) const {
+        const auto& state = bind_states[BindPointIndex(bind_point)];
+        return state.push_layout == layout && state.push_size == size &&
+               std::memcmp(state.push_data.data(), data, size) == 0;
+    }
+
+    /// Records the contents of the push constants set at the provided bind point.
+    void SetBoundPushData(vk::PipelineBindPoint bind_point, vk::PipelineLayout layout,
+                          const void* data, u32 size) {
+        auto& state = bind_states[BindPointIndex(bind_point)];
+        ASSERT(size <= state.push_data.size());
+        state.push_layout = layout;
+        state.push_size = size;
+        std::memcpy(state.push_data.data(), data, size);
+    }
+
+    /// Returns true if a descriptor set with the provided contents is still bound.
+    [[nodiscard]] bool IsDescriptorSetBound(vk::PipelineBindPoint bind_point,
+                                            vk::PipelineLayout layout,
+                                            const DescriptorSetContents& contents) const {
+        const auto& state = bind_states[BindPointIndex(bind_point)];
+        return state.set_layout == layout && state.set_contents == contents;
+    }
+
+    /// Records the contents of the descriptor set bound at the provided bind point.
+    void SetBoundDescriptorSet(vk::PipelineBindPoint bind_point, vk::PipelineLayout layout,
+                               const DescriptorSetContents& contents) {
+        auto& state = bind_states[BindPointIndex(bind_point)];
+        state.set_layout = layout;
+        state.set_contents = contents;
+    }
+
+    /// Forgets tracked pipelines, push constants and descriptor sets, must be called when a pass
+    /// binds its own state on the current command buffer.
+    void InvalidateBindings() {
+        bind_states = {};
+    }
+
     /// Returns the current command buffer.
     vk::CommandBuffer CommandBuffer() const {
         return current_cmdbuf;
@@ -370,11 +422,32 @@ public:
         pending_ops.emplace(std::move(func), CurrentTick());
     }
 
+    /// Records that a buffer or image view referenced by descriptor sets has been destroyed.
+    /// Must be called from deferred operations, once the handle may be reused.
+    void NotifyResourceDestroyed() noexcept {
+        ++resource_generation;
+    }
+
+    /// Returns a counter that changes whenever a descriptor resource has been destroyed.
+    [[nodiscard]] u64 ResourceGeneration() const noexcept {
+        return resource_generation;
+    }
+
     static std::mutex submit_mutex;
 
 private:
     void AllocateWorkerCommandBuffers();
 
+    /// Returns the render area of the current render state.
+    vk::Extent2D RenderArea() const;
+
+    /// Attempts to continue the current rendering scope with a compatible render state.
+    bool MergeRendering(const RenderState& new_state);
+
+    static constexpr u32 BindPointIndex(vk::PipelineBindPoint bind_point) {
+        return bind_point == vk::PipelineBindPoint::eCompute ? 1 : 0;
+    }
+
     void SubmitExecution(SubmitInfo& info);
 
 private:
@@ -388,9 +461,20 @@ private:
         u64 gpu_tick;
     };
     std::queue<PendingOp> pending_ops;
+    u64 resource_generation{};
     u32 op_scope{};
     RenderState render_state;
     DynamicState dynamic_state;
+    struct BindState {
+        vk::Pipeline pipeline{};
+        vk::PipelineLayout push_layout{};
+        u32 push_size{};
+        /// Vulkan guarantees at least 128 bytes of push constants, which is all the renderer uses.
+        std::array<u8, 128> push_data{};
+        vk::PipelineLayout set_layout{};
+        DescriptorSetContents set_contents{};
+    };
+    std::array<BindState, 2> bind_states{};
     bool is_rendering = false;
     tracy::VkCtxScope* profiler_scope{};
 };
@@ -1,6 +1,9 @@
 // SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <array>
+#include <optional>
+
 #include "shader_recompiler/info.h"
 #include "video_core/renderer_vulkan/vk_rasterizer.h"
 #include "video_core/renderer_vulkan/vk_scheduler.h"
@@ -12,6 +15,18 @@ namespace Vulkan {
 
 static constexpr u64 COPY_SHADER_HASH = 0xfefebf9f;
 
+static constexpr vk::MemoryBarrier READ_BARRIER{
+    .srcAccessMask = vk::AccessFlagBits::eMemoryWrite,
+    .dstAccessMask = vk::AccessFlagBits::eTransferRead | vk::AccessFlagBits::eTransferWrite,
+};
+static constexpr vk::MemoryBarrier WRITE_BARRIER{
+    .srcAccessMask = vk::AccessFlagBits::eTransferWrite,
+    .dstAccessMask = vk::AccessFlagBits::eMemoryRead | vk::AccessFlagBits::eMemoryWrite,
+};
+
+/// Bounds the invocation ids of recognized kernels, see HleSignaturePass.
+static constexpr u32 MaxHleInvocations = 1U << 23;
+
 static bool ExecuteCopyShaderHLE(const Shader::Info& info,
                                  const AmdGpu::Liverpool::ComputeProgram& cs_program,
                                  Rasterizer& rasterizer) {
@@ -47,15 +62,6 @@ static bool ExecuteCopyShaderHLE(const Shader::Info& info,
     }
 
     scheduler.EndRendering();
-
-    static constexpr vk::MemoryBarrier READ_BARRIER{
-        .srcAccessMask = vk::AccessFlagBits::eMemoryWrite,
-        .dstAccessMask = vk::AccessFlagBits::eTransferRead | vk::AccessFlagBits::eTransferWrite,
-    };
-    static constexpr vk::MemoryBarrier WRITE_BARRIER{
-        .srcAccessMask = vk::AccessFlagBits::eTransferWrite,
-        .dstAccessMask = vk::AccessFlagBits::eMemoryRead | vk::AccessFlagBits::eMemoryWrite,
-    };
     scheduler.CommandBuffer().pipelineBarrier(
         vk::PipelineStageFlagBits::eAllCommands, vk::PipelineStageFlagBits::eTransfer,
         vk::DependencyFlagBits::eByRegion, READ_BARRIER, {}, {});
@@ -121,14 +127,191 @@ static bool ExecuteCopyShaderHLE(const Shader::Info& info,
     return true;
 }
 
+/// Byte range of a buffer accessed by a recognized kernel over the whole dispatch.
+struct HleRange {
+    u64 offset;
+    u64 size;
+};
+
+static std::optional<HleRange> ResolveRange(const Shader::HleSignature::Access& access,
+                                            u32 element_size, const AmdGpu::Buffer& sharp,
+                                            const AmdGpu::Liverpool::ComputeProgram& cs_program) {
+    // The addressing was compiled for the sharp seen at the time.
+    if (sharp.stride != access.sharp_stride || sharp.swizzle_enable || sharp.add_tid_enable) {
+        return std::nullopt;
+    }
+    const std::array<u32, 3> threads{cs_program.num_thread_x.full, cs_program.num_thread_y.full,
+                                     cs_program.num_thread_z.full};
+    const std::array<u32, 3> groups{cs_program.dim_x, cs_program.dim_y, cs_program.dim_z};
+    for (u32 i = 0; i < 3; ++i) {
+        if (threads[i] >= MaxHleInvocations || groups[i] >= MaxHleInvocations) {
+            return std::nullopt;
+        }
+    }
+    // Invocations that only differ along y or z have to access the same bytes, along x they have
+    // to tile one contiguous range.
+    for (u32 i = 1; i < 3; ++i) {
+        if ((threads[i] > 1 && access.local_stride[i] != 0) ||
+            (groups[i] > 1 && access.group_stride[i] != 0)) {
+            return std::nullopt;
+        }
+    }
+    if ((threads[0] > 1 && access.local_stride[0] != element_size) ||
+        (groups[0] > 1 && access.group_stride[0] != s64{element_size} * threads[0])) {
+        return std::nullopt;
+    }
+    if (access.offset < 0 || access.offset % sizeof(u32) != 0) {
+        return std::nullopt;
+    }
+    const u64 num_invocations = u64{threads[0]} * groups[0];
+    return HleRange{static_cast<u64>(access.offset), num_invocations * element_size};
+}
+
+/// Size of the range left after the bounds checks of the shader, which drop whole elements.
+static u32 ClipToBuffer(const HleRange& range, u32 element_size, const AmdGpu::Buffer& sharp) {
+    const u64 buffer_size = sharp.GetSize();
+    if (range.offset >= buffer_size) {
+        return 0;
+    }
+    const u64 num_elements = (buffer_size - range.offset) / element_size;
+    return static_cast<u32>(std::min(range.size, num_elements * element_size));
+}
+
+static bool ExecuteFillBufferHLE(const Shader::Info& info,
+                                 const AmdGpu::Liverpool::ComputeProgram& cs_program,
+                                 Rasterizer& rasterizer) {
+    const auto& hle = info.hle;
+    const auto sharp = info.buffers[hle.dst.buffer].GetSharp(info);
+    const auto range = ResolveRange(hle.dst, hle.element_size, sharp, cs_program);
+    if (!range) {
+        return false;
+    }
+    u32 value = hle.fill_value;
+    if (hle.fill_reg != Shader::IR::ScalarReg::Max) {
+        const u32 reg = static_cast<u32>(hle.fill_reg);
+        if (reg >= info.user_data.size()) {
+            return false;
+        }
+        value = info.user_data[reg];
+    }
+    const u32 size = ClipToBuffer(*range, hle.element_size, sharp);
+    // Nothing left to transfer, let the shader run with its own bounds checks.
+    if (size == 0) {
+        return false;
+    }
+    const VAddr address = sharp.base_address + range->offset;
+    if (address % sizeof(u32) != 0) {
+        return false;
+    }
+
+    auto& scheduler = rasterizer.GetScheduler();
+    auto& buffer_cache = rasterizer.GetBufferCache();
+    auto& texture_cache = rasterizer.GetTextureCache();
+
+    // Only the bytes the kernel writes are marked as modified, not the whole binding.
+    const auto [buffer, offset] = buffer_cache.ObtainBuffer(address, size, true);
+    texture_cache.InvalidateMemoryFromGPU(address, size);
+
+    LOG_TRACE(Render_Vulkan, "HLE buffer fill: address = {:#x}, size = {}, value = {:#x}",
+              address, size, value);
+    scheduler.EndRendering();
+    const auto cmdbuf = scheduler.CommandBuffer();
+    cmdbuf.pipelineBarrier(vk::PipelineStageFlagBits::eAllCommands,
+                           vk::PipelineStageFlagBits::eTransfer, vk::DependencyFlagBits::eByRegion,
+                           READ_BARRIER, {}, {});
+    cmdbuf.fillBuffer(buffer->Handle(), offset, size, value);
+    cmdbuf.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer,
+                           vk::PipelineStageFlagBits::eAllCommands,
+                           vk::DependencyFlagBits::eByRegion, WRITE_BARRIER, {}, {});
+    return true;
+}
+
+static bool ExecuteCopyBufferHLE(const Shader::Info& info,
+                                 const AmdGpu::Liverpool::ComputeProgram& cs_program,
+                                 Rasterizer& rasterizer) {
+    const auto& hle = info.hle;
+    const auto dst_sharp = info.buffers[hle.dst.buffer].GetSharp(info);
+    const auto src_sharp = info.buffers[hle.src.buffer].GetSharp(info);
+    const auto dst_range = ResolveRange(hle.dst, hle.element_size, dst_sharp, cs_program);
+    const auto src_range = ResolveRange(hle.src, hle.element_size, src_sharp, cs_program);
+    if (!dst_range || !src_range) {
+        return false;
+    }
+    const u32 size = ClipToBuffer(*dst_range, hle.element_size, dst_sharp);
+    // Nothing left to transfer, let the shader run with its own bounds checks.
+    if (size == 0) {
+        return false;
+    }
+    // Reads past the end of the source return zeros, which a copy cannot reproduce.
+    if (src_range->offset + size > src_sharp.GetSize()) {
+        return false;
+    }
+    const VAddr src_address = src_sharp.base_address + src_range->offset;
+    const VAddr dst_address = dst_sharp.base_address + dst_range->offset;
+    // Copy commands must not overlap, leave that case to the shader.
+    if (src_address < dst_address + size && dst_address < src_address + size) {
+        return false;
+    }
+
+    auto& scheduler = rasterizer.GetScheduler();
+    auto& buffer_cache = rasterizer.GetBufferCache();
+    auto& texture_cache = rasterizer.GetTextureCache();
+
+    const auto [src_buf, src_offset] = buffer_cache.ObtainBuffer(src_address, size, false);
+    const auto [dst_buf, dst_offset] = buffer_cache.ObtainBuffer(dst_address, size, true);
+    texture_cache.InvalidateMemoryFromGPU(dst_address, size);
+
+    LOG_TRACE(Render_Vulkan, "HLE buffer copy: src = {:#x}, dst = {:#x}, size = {}", src_address,
+              dst_address, size);
+    scheduler.EndRendering();
+    const auto cmdbuf = scheduler.CommandBuffer();
+    cmdbuf.pipelineBarrier(vk::PipelineStageFlagBits::eAllCommands,
+                           vk::PipelineStageFlagBits::eTransfer, vk::DependencyFlagBits::eByRegion,
+                           READ_BARRIER, {}, {});
+    cmdbuf.copyBuffer(src_buf->Handle(), dst_buf->Handle(),
+                      vk::BufferCopy{src_offset, dst_offset, size});
+    cmdbuf.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer,
+                           vk::PipelineStageFlagBits::eAllCommands,
+                           vk::DependencyFlagBits::eByRegion, WRITE_BARRIER, {}, {});
+    return true;
+}
+
+struct ShaderHLE {
+    /// Whether the handler applies to the shader. It may still decline a particular dispatch.
+    bool (*matches)(const Shader::Info& info);
+    bool (*execute)(const Shader::Info& info, const AmdGpu::Liverpool::ComputeProgram& cs_program,
+                    Rasterizer& rasterizer);
+};
+
+static constexpr std::array ShaderHLERegistry = {
+    ShaderHLE{
+        .matches = [](const Shader::Info& info) { return info.pgm_hash == COPY_SHADER_HASH; },
+        .execute = ExecuteCopyShaderHLE,
+    },
+    ShaderHLE{
+        .matches =
+            [](const Shader::Info& info) {
+                return info.hle.type == Shader::HleSignature::Type::FillBuffer;
+            },
+        .execute = ExecuteFillBufferHLE,
+    },
+    ShaderHLE{
+        .matches =
+            [](const Shader::Info& info) {
+                return info.hle.type == Shader::HleSignature::Type::CopyBuffer;
+            },
+        .execute = ExecuteCopyBufferHLE,
+    },
+};
+
 bool ExecuteShaderHLE(const Shader::Info& info, const AmdGpu::Liverpool::Regs& regs,
                       const AmdGpu::Liverpool::ComputeProgram& cs_program, Rasterizer& rasterizer) {
-    switch (info.pgm_hash) {
-    case COPY_SHADER_HASH:
-        return ExecuteCopyShaderHLE(info, cs_program, rasterizer);
-    default:
-        return false;
+    for (const ShaderHLE& hle : ShaderHLERegistry) {
+        if (hle.matches(info)) {
+            return hle.execute(info, cs_program, rasterizer);
+        }
     }
+    return false;
 }
 
 } // namespace Vulkan
@@ -0,0 +1,141 @@
+// SPDX-FileCopyrightText: Copyright 2025 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "video_core/renderer_vulkan/vk_shader_optimizer.h"
+
+#ifdef ENABLE_SPIRV_OPT
+#include <chrono>
+#include <filesystem>
+#include <spirv-tools/optimizer.hpp>
+#include <xxhash.h>
+#include "common/config.h"
+#include "common/io_file.h"
+#include "common/logging/log.h"
+#include "common/path_util.h"
+#endif
+
+namespace Vulkan {
+
+#ifdef ENABLE_SPIRV_OPT
+
+namespace {
+
+/// Bump whenever the pass list changes so that stale cache entries are no longer hit.
+constexpr u64 OptimizerRevision = 1;
+
+/// The pipeline cache always requests SPIR-V 1.6, which is what Vulkan 1.3 consumes.
+constexpr spv_target_env TargetEnv = SPV_ENV_VULKAN_1_3;
+
+/// The SPIR-V header alone is five words: magic, version, generator, bound and schema.
+constexpr u64 MinModuleWords = 5;
+constexpr u32 SpirvMagic = 0x07230203;
+
+std::filesystem::path GetCachePath(std::span<const u32> code) {
+    using namespace Common::FS;
+    const XXH128_hash_t hash =
+        XXH3_128bits_withSeed(code.data(), code.size_bytes(), OptimizerRevision);
+    return GetUserPath(PathType::ShaderDir) / "optimized" /
+           fmt::format("{:016x}{:016x}.spv", hash.high64, hash.low64);
+}
+
+std::optional<std::vector<u32>> LoadCached(const std::filesystem::path& path) {
+    if (!std::filesystem::exists(path)) {
+        return std::nullopt;
+    }
+    const Common::FS::IOFile file{path, Common::FS::FileAccessMode::Read};
+    const u64 size = file.GetSize();
+    // Anything that is not a complete module with its header is re-optimized and overwritten.
+    if (size % sizeof(u32) != 0 || size < MinModuleWords * sizeof(u32)) {
+        LOG_WARNING(Render_Vulkan, "Ignoring malformed optimized shader {}", path.string());
+        return std::nullopt;
+    }
+    std::vector<u32> code(size / sizeof(u32));
+    if (file.Read(code) != code.size() || code[0] != SpirvMagic) {
+        LOG_WARNING(Render_Vulkan, "Ignoring malformed optimized shader {}", path.string());
+        return std::nullopt;
+    }
+    return code;
+}
+
+std::optional<std::vector<u32>> RunOptimizer(std::span<const u32> code) {
+    spvtools::Optimizer optimizer{TargetEnv};
+    optimizer.SetMessageConsumer([](spv_message_level_t level, const char*,
+                                    const spv_position_t& position, const char* message) {
+        if (level <= SPV_MSG_ERROR) {
+            LOG_ERROR(Render_Vulkan, "spirv-opt: {} (word {})", message, position.index);
+        } else {
+            LOG_DEBUG(Render_Vulkan, "spirv-opt: {} (word {})", message, position.index);
+        }
+    });
+    // Inlining, scalar replacement, copy propagation, local redundancy elimination and
+    // aggressive dead code elimination, among others.
+    optimizer.RegisterPerformancePasses();
+
+    spvtools::OptimizerOptions options;
+#ifdef NDEBUG
+    options.set_run_validator(false);
+#else
+    // Catches recompiler output that only happens to work on lenient drivers.
+    options.set_run_validator(true);
+#endif
+
+    std::vector<u32> result;
+    if (!optimizer.Run(code.data(), code.size(), &result, options)) {
+        return std::nullopt;
+    }
+    return result;
+}
+
+} // Anonymous namespace
+
+std::optional<std::vector<u32>> OptimizeSPV(std::span<const u32> code) {
+    if (!Config::optimizeShaders()) {
+        return std::nullopt;
+    }
+    const auto cache_path = GetCachePath(code);
+    if (auto cached = LoadCached(cache_path)) {
+        return cached;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    auto result = RunOptimizer(code);
+    const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start);
+    if (!result) {
+        LOG_ERROR(Render_Vulkan, "Failed to optimize shader, using it unoptimized");
+        return std::nullopt;
+    }
+    LOG_INFO(Render_Vulkan, "Optimized shader from {} to {} words in {} us", code.size(),
+             result->size(), elapsed.count());
+
+    // Write next to the entry and move it in place, so a crash never leaves a truncated entry.
+    std::filesystem::create_directories(cache_path.parent_path());
+    auto temp_path = cache_path;
+    temp_path += ".tmp";
+    bool written;
+    {
+        const Common::FS::IOFile file{temp_path, Common::FS::FileAccessMode::Write};
+        written = file.WriteSpan(std::span<const u32>{*result}) == result->size();
+    }
+    std::error_code ec;
+    if (!written) {
+        LOG_WARNING(Render_Vulkan, "Failed to write optimized shader to {}", temp_path.string());
+        std::filesystem::remove(temp_path, ec);
+        return result;
+    }
+    std::filesystem::rename(temp_path, cache_path, ec);
+    if (ec) {
+        LOG_WARNING(Render_Vulkan, "Failed to cache optimized shader: {}", ec.message());
+    }
+    return result;
+}
+
+#else
+
+std::optional<std::vector<u32>> OptimizeSPV(std::span<const u32>) {
+    return std::nullopt;
+}
+
+#endif
+
+} // namespace Vulkan
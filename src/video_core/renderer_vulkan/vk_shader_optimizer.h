@@ -0,0 +1,23 @@
+// SPDX-FileCopyrightText: Copyright 2025 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "common/types.h"
+
+namespace Vulkan {
+
+/**
+ * @brief Runs the SPIRV-Tools performance passes over recompiled SPIR-V.
+ * Results are cached on disk by the hash of the input, so every shader permutation is only
+ * optimized once. Does nothing unless built with ENABLE_SPIRV_OPT and enabled in the config.
+ * @param code The SPIR-V produced by the shader recompiler.
+ * @return The optimized SPIR-V, or nothing if the input should be used as is.
+ */
+std::optional<std::vector<u32>> OptimizeSPV(std::span<const u32> code);
+
+} // namespace Vulkan
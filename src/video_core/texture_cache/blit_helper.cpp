@@ -113,6 +113,7 @@ void BlitHelper::BlitColorToMsDepth(Image& source, Image& dest) {
     };
     cmdbuf.pushDescriptorSetKHR(vk::PipelineBindPoint::eGraphics, *single_texture_pl_layout, 0U,
                                 texture_write);
+    scheduler.InvalidateBindings();
 
     const DepthPipelineKey key{dest.info.num_samples, dest.info.pixel_format};
     const vk::Pipeline depth_pipeline = GetDepthToMsPipeline(key);
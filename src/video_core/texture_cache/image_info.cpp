@@ -1,6 +1,8 @@
 // SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <xxhash.h>
+
 #include "common/assert.h"
 #include "common/config.h"
 #include "core/libraries/kernel/process.h"
@@ -226,24 +228,45 @@ bool ImageInfo::IsTilingCompatible(u32 lhs, u32 rhs) const {
     return false;
 }
 
-void ImageInfo::UpdateSize() {
+/// Parameters the mip layout of a surface depends on under the GCN tiling rules.
+struct MipLayoutKey {
+    u32 num_bits;
+    u32 pitch;
+    u32 height;
+    u32 depth;
+    u32 levels;
+    u32 layers;
+    u32 num_samples;
+    u32 tiling_mode;
+    u32 tiling_idx;
+    u32 is_block;
+    u32 is_pow2;
+    u32 alt_tile;
+
+    bool operator==(const MipLayoutKey&) const = default;
+};
+static_assert(std::has_unique_object_representations_v<MipLayoutKey>);
+
+static u32 ComputeMipsLayout(const MipLayoutKey& key,
+                             boost::container::small_vector<ImageInfo::MipInfo, 14>& mips_layout) {
     mips_layout.clear();
-    MipInfo mip_info{};
-    guest_size = 0;
-    for (auto mip = 0u; mip < resources.levels; ++mip) {
-        auto bpp = num_bits;
-        auto mip_w = pitch >> mip;
-        auto mip_h = size.height >> mip;
-        if (props.is_block) {
+    ImageInfo::MipInfo mip_info{};
+    u32 guest_size = 0;
+    const auto tiling_mode = static_cast<AmdGpu::TilingMode>(key.tiling_mode);
+    for (auto mip = 0u; mip < key.levels; ++mip) {
+        auto bpp = key.num_bits;
+        auto mip_w = key.pitch >> mip;
+        auto mip_h = key.height >> mip;
+        if (key.is_block) {
             mip_w = (mip_w + 3) / 4;
             mip_h = (mip_h + 3) / 4;
         }
         mip_w = std::max(mip_w, 1u);
         mip_h = std::max(mip_h, 1u);
-        auto mip_d = std::max(size.depth >> mip, 1u);
+        auto mip_d = std::max(key.depth >> mip, 1u);
         auto thickness = 1;
 
-        if (props.is_pow2) {
+        if (key.is_pow2) {
             mip_w = std::bit_ceil(mip_w);
             mip_h = std::bit_ceil(mip_h);
             mip_d = std::bit_ceil(mip_d);
@@ -252,7 +275,7 @@ void ImageInfo::UpdateSize() {
         switch (tiling_mode) {
         case AmdGpu::TilingMode::Display_Linear: {
             std::tie(mip_info.pitch, mip_info.size) =
-                ImageSizeLinearAligned(mip_w, mip_h, bpp, num_samples);
+                ImageSizeLinearAligned(mip_w, mip_h, bpp, key.num_samples);
             break;
         }
         case AmdGpu::TilingMode::Texture_Volume:
@@ -262,15 +285,16 @@ void ImageInfo::UpdateSize() {
         case AmdGpu::TilingMode::Display_MicroTiled:
         case AmdGpu::TilingMode::Texture_MicroTiled: {
             std::tie(mip_info.pitch, mip_info.size) =
-                ImageSizeMicroTiled(mip_w, mip_h, thickness, bpp, num_samples);
+                ImageSizeMicroTiled(mip_w, mip_h, thickness, bpp, key.num_samples);
             break;
         }
         case AmdGpu::TilingMode::Display_MacroTiled:
         case AmdGpu::TilingMode::Texture_MacroTiled:
         case AmdGpu::TilingMode::Depth_MacroTiled: {
-            ASSERT(!props.is_block);
-            std::tie(mip_info.pitch, mip_info.size) = ImageSizeMacroTiled(
-                mip_w, mip_h, thickness, bpp, num_samples, tiling_idx, mip, alt_tile);
+            ASSERT(!key.is_block);
+            std::tie(mip_info.pitch, mip_info.size) =
+                ImageSizeMacroTiled(mip_w, mip_h, thickness, bpp, key.num_samples,
+                                    key.tiling_idx, mip, key.alt_tile);
             break;
         }
         default: {
@@ -278,15 +302,53 @@ void ImageInfo::UpdateSize() {
         }
         }
         mip_info.height = mip_h;
-        if (props.is_block) {
+        if (key.is_block) {
             mip_info.pitch = std::max(mip_info.pitch * 4, 32u);
             mip_info.height = std::max(mip_info.height * 4, 32u);
         }
-        mip_info.size *= mip_d * resources.layers;
+        mip_info.size *= mip_d * key.layers;
         mip_info.offset = guest_size;
         mips_layout.emplace_back(mip_info);
         guest_size += mip_info.size;
     }
+    return guest_size;
+}
+
+void ImageInfo::UpdateSize() {
+    const MipLayoutKey key{
+        .num_bits = num_bits,
+        .pitch = pitch,
+        .height = size.height,
+        .depth = size.depth,
+        .levels = resources.levels,
+        .layers = resources.layers,
+        .num_samples = num_samples,
+        .tiling_mode = static_cast<u32>(tiling_mode),
+        .tiling_idx = tiling_idx,
+        .is_block = props.is_block,
+        .is_pow2 = props.is_pow2,
+        .alt_tile = alt_tile,
+    };
+
+    // Surfaces are described over and over with the same parameters, so memoize computed
+    // layouts in a small direct mapped table. It is kept per thread to stay lock-free.
+    struct CacheEntry {
+        MipLayoutKey key;
+        u32 guest_size;
+        boost::container::small_vector<MipInfo, 14> mips_layout;
+        bool valid;
+    };
+    static constexpr size_t NumCacheEntries = 64;
+    thread_local std::array<CacheEntry, NumCacheEntries> layout_cache{};
+
+    auto& entry = layout_cache[XXH3_64bits(&key, sizeof(key)) % NumCacheEntries];
+    if (!entry.valid || entry.key != key) {
+        entry.guest_size = ComputeMipsLayout(key, entry.mips_layout);
+        entry.key = key;
+        entry.valid = true;
+    }
+    mips_layout = entry.mips_layout;
+    guest_size = entry.guest_size;
 }
 
 s32 ImageInfo::MipOf(const ImageInfo& info) const {
@@ -1,6 +1,7 @@
 // SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <cstring>
 #include <optional>
 #include <xxhash.h>
 
@@ -425,6 +426,42 @@ ImageId TextureCache::FindImage(BaseDesc& desc, FindFlags flags) {
     return image_id;
 }
 
+static u64 TextureDescSeed(const Shader::ImageResource& res) {
+    return u64(res.is_depth) | u64(res.is_atomic) << 1 | u64(res.is_array) << 2 |
+           u64(res.is_written) << 3 | u64(res.is_r128) << 4 | u64(res.force_degamma) << 5;
+}
+
+ImageId TextureCache::FindTextureImage(const AmdGpu::Image& image,
+                                       const Shader::ImageResource& res, TextureDesc& desc) {
+    const u64 generation = registration_generation.load(std::memory_order_acquire);
+    if (texture_descs_generation != generation || texture_descs.size() >= MaxTextureDescCacheSize) {
+        texture_descs.clear();
+        texture_descs_generation = generation;
+    }
+
+    const u64 res_flags = TextureDescSeed(res);
+    const u64 key = XXH3_64bits_withSeed(&image, sizeof(image), res_flags);
+    if (const auto it = texture_descs.find(key); it != texture_descs.end()) {
+        // Compare the full sharp, a hash collision must not bind the wrong image.
+        const TextureDescEntry& entry = it->second;
+        if (entry.res_flags == res_flags &&
+            std::memcmp(&entry.sharp, &image, sizeof(image)) == 0) {
+            desc = entry.desc;
+            slot_images[entry.image_id].tick_accessed_last = scheduler.CurrentTick();
+            return entry.image_id;
+        }
+    }
+
+    desc = TextureDesc{image, res};
+    const ImageId image_id = FindImage(desc);
+
+    // Only memoize lookups that did not create or evict images, as those will be flushed anyway.
+    if (registration_generation.load(std::memory_order_acquire) == generation) {
+        texture_descs.insert_or_assign(key, TextureDescEntry{image, res_flags, image_id, desc});
+    }
+    return image_id;
+}
+
 ImageView& TextureCache::RegisterImageView(ImageId image_id, const ImageViewInfo& view_info) {
     Image& image = slot_images[image_id];
     if (const ImageViewId view_id = image.FindView(view_info); view_id) {
@@ -669,6 +706,7 @@ void TextureCache::RegisterImage(ImageId image_id) {
     ASSERT_MSG(False(image.flags & ImageFlagBits::Registered),
                "Trying to register an already registered image");
     image.flags |= ImageFlagBits::Registered;
+    registration_generation.fetch_add(1, std::memory_order_release);
     ForEachPage(image.info.guest_address, image.info.guest_size,
                 [this, image_id](u64 page) { page_table[page].push_back(image_id); });
 }
@@ -678,6 +716,7 @@ void TextureCache::UnregisterImage(ImageId image_id) {
     ASSERT_MSG(True(image.flags & ImageFlagBits::Registered),
                "Trying to unregister an already unregistered image");
     image.flags &= ~ImageFlagBits::Registered;
+    registration_generation.fetch_add(1, std::memory_order_release);
     ForEachPage(image.info.guest_address, image.info.guest_size, [this, image_id](u64 page) {
         const auto page_it = page_table.find(page);
         if (page_it == nullptr) {
@@ -826,6 +865,7 @@ void TextureCache::DeleteImage(ImageId image_id) {
             slot_image_views.erase(image_view_id);
         }
         slot_images.erase(image_id);
+        scheduler.NotifyResourceDestroyed();
     });
 }
 
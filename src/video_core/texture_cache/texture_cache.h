@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <boost/container/small_vector.hpp>
 #include <tsl/robin_map.h>
 
@@ -35,6 +36,7 @@ enum class FindFlags {
 DECLARE_ENUM_FLAG_OPERATORS(FindFlags)
 
 static constexpr u32 MaxInvalidateDist = 12_MB;
+static constexpr size_t MaxTextureDescCacheSize = 4096;
 
 class TextureCache {
     struct Traits {
@@ -114,6 +116,11 @@ public:
     /// Retrieves the image handle of the image with the provided attributes.
     [[nodiscard]] ImageId FindImage(BaseDesc& desc, FindFlags flags = {});
 
+    /// Retrieves the image referenced by a T# descriptor, memoizing the resolved description
+    /// until the set of registered images changes.
+    [[nodiscard]] ImageId FindTextureImage(const AmdGpu::Image& image,
+                                           const Shader::ImageResource& res, TextureDesc& desc);
+
     /// Retrieves an image view with the properties of the specified image id.
     [[nodiscard]] ImageView& FindTexture(ImageId image_id, const ImageViewInfo& view_info);
 
@@ -312,6 +319,19 @@ private:
         u32 clear_mask{u32(-1)};
     };
     tsl::robin_map<VAddr, MetaDataInfo> surface_metas;
+
+    // Resolved texture bindings keyed by a hash of the raw T# bits and resource flags. The cache
+    // is dropped whenever an image is registered or unregistered, as lookups may then resolve
+    // differently.
+    struct TextureDescEntry {
+        AmdGpu::Image sharp;
+        u64 res_flags;
+        ImageId image_id;
+        TextureDesc desc;
+    };
+    tsl::robin_map<u64, TextureDescEntry> texture_descs;
+    std::atomic<u64> registration_generation{};
+    u64 texture_descs_generation{};
 };
 
 } // namespace VideoCore
@@ -262,6 +262,7 @@ std::pair<vk::Buffer, u32> TileManager::TryDetile(vk::Buffer in_buffer, u32 in_o
     };
     cmdbuf.pushDescriptorSetKHR(vk::PipelineBindPoint::eCompute, *detiler->pl_layout, 0,
                                 set_writes);
+    scheduler.InvalidateBindings();
 
     DetilerParams params;
     params.num_levels = info.resources.levels;